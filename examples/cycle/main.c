@@ -0,0 +1,374 @@
+/*****************************************************************************
+ *
+ *  $Id$
+ *
+ *  Copyright (C) 2007-2009  Florian Pose, Ingenieurgemeinschaft IgH
+ *
+ *  This file is part of the IgH EtherCAT Master.
+ *
+ *  The IgH EtherCAT Master is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License version 2, as
+ *  published by the Free Software Foundation.
+ *
+ *  The IgH EtherCAT Master is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ *  Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with the IgH EtherCAT Master; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *  ---
+ *
+ *  The license mentioned above concerns the source code only. Using the
+ *  EtherCAT technology and brand is only permitted in compliance with the
+ *  industrial property and similar rights of Beckhoff Automation GmbH.
+ *
+ ****************************************************************************/
+
+/** \file
+ *
+ * Compares the cycle time of the per-call cyclic path with
+ * ecrt_master_cycle().
+ *
+ * The example creates a number of (empty) domains and runs a cyclic task,
+ * that alternates between two variants of the same cycle: Receiving,
+ * processing the domains and reading their states, the distributed clocks
+ * operations, queueing the domains and sending. The per-call variant uses
+ * one library call (and system call) per operation and domain, the batched
+ * variant uses two calls to ecrt_master_cycle(). The execution times of both
+ * variants are reported.
+ *
+ * No slave configurations are created, so the example can be used with any
+ * bus.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h> /* clock_gettime() */
+#include <sys/mman.h> /* mlockall() */
+#include <sched.h> /* sched_setscheduler() */
+
+/****************************************************************************/
+
+#include "ecrt.h"
+
+/****************************************************************************/
+
+#define NSEC_PER_SEC (1000000000)
+
+#define MAX_SAFE_STACK (8 * 1024) /* The maximum stack size which is
+                                     guranteed safe to access without
+                                     faulting */
+
+#define MAX_DOMAINS 16
+
+/****************************************************************************/
+
+/** Execution time statistics of one variant.
+ */
+typedef struct {
+    unsigned long count; /**< Number of measurements. */
+    long long sum_ns; /**< Sum of the execution times. */
+    long max_ns; /**< Worst-case execution time. */
+} timing_t;
+
+/** Cycle variants. */
+enum {
+    VARIANT_PER_CALL,
+    VARIANT_BATCHED,
+    VARIANT_COUNT
+};
+
+static const char *variant_names[VARIANT_COUNT] = {
+    "per-call",
+    "batched"
+};
+
+/****************************************************************************/
+
+static ec_master_t *master = NULL;
+static volatile sig_atomic_t run = 1;
+
+static ec_domain_t *domains[MAX_DOMAINS];
+static ec_cycle_domain_t cycle_domains[MAX_DOMAINS];
+static unsigned int domain_count = 4;
+
+static timing_t stats[VARIANT_COUNT];
+static timing_t second_stats[VARIANT_COUNT];
+
+/****************************************************************************/
+
+static long diff_ns(const struct timespec *a, const struct timespec *b)
+{
+    return (b->tv_sec - a->tv_sec) * NSEC_PER_SEC
+        + (b->tv_nsec - a->tv_nsec);
+}
+
+/****************************************************************************/
+
+static uint64_t timespec_to_ns(const struct timespec *t)
+{
+    return (uint64_t) t->tv_sec * NSEC_PER_SEC + t->tv_nsec;
+}
+
+/****************************************************************************/
+
+static void account(timing_t *timing, long ns)
+{
+    timing->count++;
+    timing->sum_ns += ns;
+    if (ns > timing->max_ns) {
+        timing->max_ns = ns;
+    }
+}
+
+/****************************************************************************/
+
+static void print_timing(const char *name, const timing_t *timing,
+        unsigned int calls)
+{
+    if (!timing->count) {
+        printf("  %-8s no cycles\n", name);
+        return;
+    }
+
+    printf("  %-8s %2u calls, avg %6.1f us, max %6.1f us (%lu cycles)\n",
+            name, calls, timing->sum_ns / 1000.0 / timing->count,
+            timing->max_ns / 1000.0, timing->count);
+}
+
+/****************************************************************************/
+
+/** Number of library calls per cycle of a variant.
+ */
+static unsigned int calls_per_cycle(int variant)
+{
+    if (variant == VARIANT_BATCHED) {
+        return 2;
+    }
+
+    /* receive, process and state per domain, application time, reference
+     * clock, slave clocks, queue per domain, send */
+    return 3 * domain_count + 5;
+}
+
+/****************************************************************************/
+
+static void cycle_per_call(uint64_t app_time)
+{
+    ec_domain_state_t state;
+    unsigned int i;
+
+    ecrt_master_receive(master);
+    for (i = 0; i < domain_count; i++) {
+        ecrt_domain_process(domains[i]);
+        ecrt_domain_state(domains[i], &state);
+    }
+
+    ecrt_master_application_time(master, app_time);
+    ecrt_master_sync_reference_clock(master);
+    ecrt_master_sync_slave_clocks(master);
+    for (i = 0; i < domain_count; i++) {
+        ecrt_domain_queue(domains[i]);
+    }
+    ecrt_master_send(master);
+}
+
+/****************************************************************************/
+
+static void cycle_batched(uint64_t app_time)
+{
+    ec_cycle_t cycle = {};
+
+    cycle.domains = cycle_domains;
+    cycle.domain_count = domain_count;
+
+    cycle.operations = EC_CYCLE_RECEIVE | EC_CYCLE_PROCESS;
+    ecrt_master_cycle(master, &cycle);
+
+    cycle.operations = EC_CYCLE_APP_TIME | EC_CYCLE_SYNC_REF
+        | EC_CYCLE_SYNC_SLAVES | EC_CYCLE_QUEUE | EC_CYCLE_SEND;
+    cycle.app_time = app_time;
+    ecrt_master_cycle(master, &cycle);
+}
+
+/****************************************************************************/
+
+static void cyclic_task(int variant)
+{
+    struct timespec t0, t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (variant == VARIANT_BATCHED) {
+        cycle_batched(timespec_to_ns(&t0));
+    } else {
+        cycle_per_call(timespec_to_ns(&t0));
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    account(&stats[variant], diff_ns(&t0, &t1));
+    account(&second_stats[variant], diff_ns(&t0, &t1));
+}
+
+/****************************************************************************/
+
+static void stack_prefault(void)
+{
+    unsigned char dummy[MAX_SAFE_STACK];
+
+    memset(dummy, 0, MAX_SAFE_STACK);
+}
+
+/****************************************************************************/
+
+static void signal_handler(int signum)
+{
+    run = 0;
+}
+
+/****************************************************************************/
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-m MASTER] [-d DOMAINS] [-p PERIOD_US]"
+            " [-t SECONDS]\n"
+            "  -m  Master index (default 0).\n"
+            "  -d  Number of domains (1 to %u, default 4).\n"
+            "  -p  Cycle period in microseconds (default 1000).\n"
+            "  -t  Run time in seconds (default 0: until interrupted).\n",
+            name, MAX_DOMAINS);
+}
+
+/****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    struct timespec wakeup_time;
+    struct sched_param param = {};
+    unsigned int master_index = 0, period_us = 1000, seconds = 0;
+    unsigned int counter = 0, elapsed = 0, i;
+    int opt, variant = VARIANT_PER_CALL, ret = 0;
+
+    while ((opt = getopt(argc, argv, "m:d:p:t:h")) != -1) {
+        switch (opt) {
+            case 'm':
+                master_index = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                domain_count = strtoul(optarg, NULL, 0);
+                break;
+            case 'p':
+                period_us = strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                seconds = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (!domain_count || domain_count > MAX_DOMAINS) {
+        fprintf(stderr, "Invalid number of domains.\n");
+        return 1;
+    }
+
+    if (!period_us || period_us > 1000000) {
+        fprintf(stderr, "Invalid period.\n");
+        return 1;
+    }
+
+    master = ecrt_request_master(master_index);
+    if (!master) {
+        return -1;
+    }
+
+    for (i = 0; i < domain_count; i++) {
+        domains[i] = ecrt_master_create_domain(master);
+        if (!domains[i]) {
+            return -1;
+        }
+        cycle_domains[i].domain = domains[i];
+    }
+
+    printf("Activating master...\n");
+    if (ecrt_master_activate(master)) {
+        return -1;
+    }
+
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    printf("Using priority %i.\n", param.sched_priority);
+    if (sched_setscheduler(0, SCHED_FIFO, &param) == -1) {
+        perror("sched_setscheduler failed");
+    }
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1) {
+        fprintf(stderr, "Warning: Failed to lock memory: %s\n",
+                strerror(errno));
+    }
+
+    stack_prefault();
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    printf("Starting RT task with dt=%u us and %u domains.\n",
+            period_us, domain_count);
+
+    clock_gettime(CLOCK_MONOTONIC, &wakeup_time);
+    wakeup_time.tv_sec += 1; /* start in future */
+    wakeup_time.tv_nsec = 0;
+
+    while (run) {
+        ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+                &wakeup_time, NULL);
+        if (ret) {
+            if (ret == EINTR) {
+                ret = 0;
+                continue;
+            }
+            fprintf(stderr, "clock_nanosleep(): %s\n", strerror(ret));
+            break;
+        }
+
+        /* alternate the variants, so that both see the same conditions */
+        cyclic_task(variant);
+        variant = (variant + 1) % VARIANT_COUNT;
+
+        if (++counter * period_us >= 1000000) { // once per second
+            printf("%5u s: per-call max %6.1f us, batched max %6.1f us\n",
+                    ++elapsed,
+                    second_stats[VARIANT_PER_CALL].max_ns / 1000.0,
+                    second_stats[VARIANT_BATCHED].max_ns / 1000.0);
+            memset(second_stats, 0, sizeof(second_stats));
+            counter = 0;
+
+            if (seconds && elapsed >= seconds) {
+                break;
+            }
+        }
+
+        wakeup_time.tv_nsec += period_us * 1000;
+        while (wakeup_time.tv_nsec >= NSEC_PER_SEC) {
+            wakeup_time.tv_nsec -= NSEC_PER_SEC;
+            wakeup_time.tv_sec++;
+        }
+    }
+
+    printf("Cycle times:\n");
+    for (i = 0; i < VARIANT_COUNT; i++) {
+        print_timing(variant_names[i], &stats[i], calls_per_cycle(i));
+    }
+
+    ecrt_release_master(master);
+    return ret;
+}
+
+/****************************************************************************/
@@ -0,0 +1,297 @@
+/*****************************************************************************
+ *
+ *  $Id$
+ *
+ *  Copyright (C) 2007-2009  Florian Pose, Ingenieurgemeinschaft IgH
+ *
+ *  This file is part of the IgH EtherCAT Master.
+ *
+ *  The IgH EtherCAT Master is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License version 2, as
+ *  published by the Free Software Foundation.
+ *
+ *  The IgH EtherCAT Master is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ *  Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with the IgH EtherCAT Master; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *  ---
+ *
+ *  The license mentioned above concerns the source code only. Using the
+ *  EtherCAT technology and brand is only permitted in compliance with the
+ *  industrial property and similar rights of Beckhoff Automation GmbH.
+ *
+ ****************************************************************************/
+
+/** \file
+ *
+ * Measures the execution time of ecrt_master_receive() and
+ * ecrt_master_send() in a cyclic realtime task.
+ *
+ * The worst-case times are reported separately for cycles, in which the
+ * master is scanning the bus, and for the other cycles. To provoke bus
+ * scans, run the following in a second shell while the example is running:
+ *
+ * \code
+ * while true; do ethercat rescan; sleep 1; done
+ * \endcode
+ *
+ * No slave configurations are created, so the example can be used with any
+ * bus.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h> /* clock_gettime() */
+#include <sys/mman.h> /* mlockall() */
+#include <sched.h> /* sched_setscheduler() */
+
+/****************************************************************************/
+
+#include "ecrt.h"
+
+/****************************************************************************/
+
+#define NSEC_PER_SEC (1000000000)
+
+#define MAX_SAFE_STACK (8 * 1024) /* The maximum stack size which is
+                                     guranteed safe to access without
+                                     faulting */
+
+/****************************************************************************/
+
+/** Execution time statistics of one function.
+ */
+typedef struct {
+    unsigned long count; /**< Number of measurements. */
+    long long sum_ns; /**< Sum of the execution times. */
+    long max_ns; /**< Worst-case execution time. */
+} timing_t;
+
+/** Statistics for cycles without and with bus scan. */
+enum {
+    PHASE_IDLE,
+    PHASE_SCAN,
+    PHASE_COUNT
+};
+
+static const char *phase_names[PHASE_COUNT] = {
+    "no scan",
+    "scanning"
+};
+
+/****************************************************************************/
+
+static ec_master_t *master = NULL;
+static volatile sig_atomic_t run = 1;
+
+static timing_t receive_stats[PHASE_COUNT];
+static timing_t send_stats[PHASE_COUNT];
+static timing_t second_receive, second_send;
+static unsigned int scan_cycles;
+
+/****************************************************************************/
+
+static long diff_ns(const struct timespec *a, const struct timespec *b)
+{
+    return (b->tv_sec - a->tv_sec) * NSEC_PER_SEC
+        + (b->tv_nsec - a->tv_nsec);
+}
+
+/****************************************************************************/
+
+static void account(timing_t *timing, long ns)
+{
+    timing->count++;
+    timing->sum_ns += ns;
+    if (ns > timing->max_ns) {
+        timing->max_ns = ns;
+    }
+}
+
+/****************************************************************************/
+
+static void print_timing(const char *name, const timing_t *timing)
+{
+    if (!timing->count) {
+        printf("  %-8s no cycles\n", name);
+        return;
+    }
+
+    printf("  %-8s avg %6.1f us, max %6.1f us (%lu cycles)\n", name,
+            timing->sum_ns / 1000.0 / timing->count,
+            timing->max_ns / 1000.0, timing->count);
+}
+
+/****************************************************************************/
+
+static void cyclic_task(void)
+{
+    struct timespec t0, t1, t2;
+    ec_master_state_t ms;
+    int phase;
+
+    ecrt_master_state(master, &ms);
+    phase = ms.scan_busy ? PHASE_SCAN : PHASE_IDLE;
+    if (phase == PHASE_SCAN) {
+        scan_cycles++;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    ecrt_master_receive(master);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ecrt_master_send(master);
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    account(&receive_stats[phase], diff_ns(&t0, &t1));
+    account(&send_stats[phase], diff_ns(&t1, &t2));
+    account(&second_receive, diff_ns(&t0, &t1));
+    account(&second_send, diff_ns(&t1, &t2));
+}
+
+/****************************************************************************/
+
+static void stack_prefault(void)
+{
+    unsigned char dummy[MAX_SAFE_STACK];
+
+    memset(dummy, 0, MAX_SAFE_STACK);
+}
+
+/****************************************************************************/
+
+static void signal_handler(int signum)
+{
+    run = 0;
+}
+
+/****************************************************************************/
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-m MASTER] [-p PERIOD_US] [-t SECONDS]\n"
+            "  -m  Master index (default 0).\n"
+            "  -p  Cycle period in microseconds (default 1000).\n"
+            "  -t  Run time in seconds (default 0: until interrupted).\n",
+            name);
+}
+
+/****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    struct timespec wakeup_time;
+    struct sched_param param = {};
+    unsigned int master_index = 0, period_us = 1000, seconds = 0;
+    unsigned int counter = 0, elapsed = 0, i;
+    int opt, ret = 0;
+
+    while ((opt = getopt(argc, argv, "m:p:t:h")) != -1) {
+        switch (opt) {
+            case 'm':
+                master_index = strtoul(optarg, NULL, 0);
+                break;
+            case 'p':
+                period_us = strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                seconds = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (!period_us || period_us > 1000000) {
+        fprintf(stderr, "Invalid period.\n");
+        return 1;
+    }
+
+    master = ecrt_request_master(master_index);
+    if (!master) {
+        return -1;
+    }
+
+    printf("Activating master...\n");
+    if (ecrt_master_activate(master)) {
+        return -1;
+    }
+
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    printf("Using priority %i.\n", param.sched_priority);
+    if (sched_setscheduler(0, SCHED_FIFO, &param) == -1) {
+        perror("sched_setscheduler failed");
+    }
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1) {
+        fprintf(stderr, "Warning: Failed to lock memory: %s\n",
+                strerror(errno));
+    }
+
+    stack_prefault();
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    printf("Starting RT task with dt=%u us.\n", period_us);
+
+    clock_gettime(CLOCK_MONOTONIC, &wakeup_time);
+    wakeup_time.tv_sec += 1; /* start in future */
+    wakeup_time.tv_nsec = 0;
+
+    while (run) {
+        ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+                &wakeup_time, NULL);
+        if (ret) {
+            if (ret == EINTR) {
+                ret = 0;
+                continue;
+            }
+            fprintf(stderr, "clock_nanosleep(): %s\n", strerror(ret));
+            break;
+        }
+
+        cyclic_task();
+
+        if (++counter * period_us >= 1000000) { // once per second
+            printf("%5u s: receive max %6.1f us, send max %6.1f us%s\n",
+                    ++elapsed, second_receive.max_ns / 1000.0,
+                    second_send.max_ns / 1000.0,
+                    scan_cycles ? " (scanning)" : "");
+            memset(&second_receive, 0, sizeof(second_receive));
+            memset(&second_send, 0, sizeof(second_send));
+            scan_cycles = 0;
+            counter = 0;
+
+            if (seconds && elapsed >= seconds) {
+                break;
+            }
+        }
+
+        wakeup_time.tv_nsec += period_us * 1000;
+        while (wakeup_time.tv_nsec >= NSEC_PER_SEC) {
+            wakeup_time.tv_nsec -= NSEC_PER_SEC;
+            wakeup_time.tv_sec++;
+        }
+    }
+
+    for (i = 0; i < PHASE_COUNT; i++) {
+        printf("Cycles %s:\n", phase_names[i]);
+        print_timing("receive", &receive_stats[i]);
+        print_timing("send", &send_stats[i]);
+    }
+
+    ecrt_release_master(master);
+    return ret;
+}
+
+/****************************************************************************/
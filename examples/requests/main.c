@@ -0,0 +1,361 @@
+/*****************************************************************************
+ *
+ *  $Id$
+ *
+ *  Copyright (C) 2007-2009  Florian Pose, Ingenieurgemeinschaft IgH
+ *
+ *  This file is part of the IgH EtherCAT Master.
+ *
+ *  The IgH EtherCAT Master is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License version 2, as
+ *  published by the Free Software Foundation.
+ *
+ *  The IgH EtherCAT Master is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ *  Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with the IgH EtherCAT Master; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *  ---
+ *
+ *  The license mentioned above concerns the source code only. Using the
+ *  EtherCAT technology and brand is only permitted in compliance with the
+ *  industrial property and similar rights of Beckhoff Automation GmbH.
+ *
+ ****************************************************************************/
+
+/** \file
+ *
+ * Measures the cost of driving SDO requests from a cyclic realtime task.
+ *
+ * The example creates a number of SDO upload requests for each of a number
+ * of consecutive slaves and keeps all of them busy: Every cycle, the state
+ * of each request is polled with ecrt_sdo_request_state(), and finished
+ * requests are started again with ecrt_sdo_request_read(). The execution
+ * times of these calls are reported. If the master provides the request
+ * ring, they access shared memory only, otherwise each of them is a system
+ * call.
+ *
+ * The completed uploads per second are reported in total and per slave. Run
+ * the example with an increasing number of slaves (-c) to see how the
+ * mailbox throughput scales with the number of slaves.
+ *
+ * The default object is the device type (0x1000:00), which every CoE slave
+ * provides.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h> /* clock_gettime() */
+#include <sys/mman.h> /* mlockall() */
+#include <sched.h> /* sched_setscheduler() */
+
+/****************************************************************************/
+
+#include "ecrt.h"
+
+/****************************************************************************/
+
+#define NSEC_PER_SEC (1000000000)
+
+#define MAX_SAFE_STACK (8 * 1024) /* The maximum stack size which is
+                                     guranteed safe to access without
+                                     faulting */
+
+#define MAX_REQUESTS 256
+
+/****************************************************************************/
+
+/** Execution time statistics of one function.
+ */
+typedef struct {
+    unsigned long count; /**< Number of measurements. */
+    long long sum_ns; /**< Sum of the execution times. */
+    long max_ns; /**< Worst-case execution time. */
+} timing_t;
+
+/****************************************************************************/
+
+static ec_master_t *master = NULL;
+static volatile sig_atomic_t run = 1;
+
+static ec_sdo_request_t *requests[MAX_REQUESTS];
+static unsigned int request_count;
+
+static timing_t state_stats, read_stats;
+static unsigned long completed, errors;
+
+/****************************************************************************/
+
+static long diff_ns(const struct timespec *a, const struct timespec *b)
+{
+    return (b->tv_sec - a->tv_sec) * NSEC_PER_SEC
+        + (b->tv_nsec - a->tv_nsec);
+}
+
+/****************************************************************************/
+
+static void account(timing_t *timing, long ns)
+{
+    timing->count++;
+    timing->sum_ns += ns;
+    if (ns > timing->max_ns) {
+        timing->max_ns = ns;
+    }
+}
+
+/****************************************************************************/
+
+static void print_timing(const char *name, const timing_t *timing)
+{
+    if (!timing->count) {
+        printf("  %-6s no calls\n", name);
+        return;
+    }
+
+    printf("  %-6s avg %7.3f us, max %7.3f us (%lu calls)\n", name,
+            timing->sum_ns / 1000.0 / timing->count,
+            timing->max_ns / 1000.0, timing->count);
+}
+
+/****************************************************************************/
+
+static void cyclic_task(void)
+{
+    struct timespec t0, t1;
+    ec_request_state_t state;
+    unsigned int i;
+
+    ecrt_master_receive(master);
+
+    for (i = 0; i < request_count; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        state = ecrt_sdo_request_state(requests[i]);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        account(&state_stats, diff_ns(&t0, &t1));
+
+        if (state == EC_REQUEST_BUSY) {
+            continue;
+        }
+
+        if (state == EC_REQUEST_SUCCESS) {
+            completed++;
+        } else if (state == EC_REQUEST_ERROR) {
+            errors++;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        ecrt_sdo_request_read(requests[i]);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        account(&read_stats, diff_ns(&t0, &t1));
+    }
+
+    ecrt_master_send(master);
+}
+
+/****************************************************************************/
+
+static void stack_prefault(void)
+{
+    unsigned char dummy[MAX_SAFE_STACK];
+
+    memset(dummy, 0, MAX_SAFE_STACK);
+}
+
+/****************************************************************************/
+
+static void signal_handler(int signum)
+{
+    run = 0;
+}
+
+/****************************************************************************/
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-m MASTER] [-s POSITION] [-c SLAVES]"
+            " [-n REQUESTS]\n"
+            "        [-o INDEX:SUBINDEX] [-p PERIOD_US] [-t SECONDS]\n"
+            "  -m  Master index (default 0).\n"
+            "  -s  Position of the first slave (default 0).\n"
+            "  -c  Number of slaves (default 1).\n"
+            "  -n  SDO requests per slave (default 1, at most %u in"
+            " total).\n"
+            "  -o  Object to upload (default 0x1000:0).\n"
+            "  -p  Cycle period in microseconds (default 1000).\n"
+            "  -t  Run time in seconds (default 0: until interrupted).\n",
+            name, MAX_REQUESTS);
+}
+
+/****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    struct timespec wakeup_time;
+    struct sched_param param = {};
+    ec_slave_info_t slave;
+    ec_slave_config_t *sc;
+    unsigned int master_index = 0, position = 0, slave_count = 1;
+    unsigned int per_slave = 1, period_us = 1000;
+    unsigned int seconds = 0, counter = 0, elapsed = 0, i, j;
+    unsigned int sdo_index = 0x1000, sdo_subindex = 0;
+    unsigned long last_completed = 0;
+    int opt, ret = 0;
+
+    while ((opt = getopt(argc, argv, "m:s:c:n:o:p:t:h")) != -1) {
+        switch (opt) {
+            case 'm':
+                master_index = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                position = strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                slave_count = strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                per_slave = strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+                if (sscanf(optarg, "%i:%i", &sdo_index, &sdo_subindex)
+                        != 2) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'p':
+                period_us = strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                seconds = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (!slave_count || !per_slave
+            || slave_count * per_slave > MAX_REQUESTS) {
+        fprintf(stderr, "Invalid number of slaves or requests.\n");
+        return 1;
+    }
+
+    if (!period_us || period_us > 1000000) {
+        fprintf(stderr, "Invalid period.\n");
+        return 1;
+    }
+
+    master = ecrt_request_master(master_index);
+    if (!master) {
+        return -1;
+    }
+
+    for (i = 0; i < slave_count; i++) {
+        if (ecrt_master_get_slave(master, position + i, &slave)) {
+            fprintf(stderr, "Failed to get slave %u.\n", position + i);
+            return -1;
+        }
+
+        sc = ecrt_master_slave_config(master, 0, position + i,
+                slave.vendor_id, slave.product_code);
+        if (!sc) {
+            return -1;
+        }
+
+        for (j = 0; j < per_slave; j++) {
+            requests[request_count] = ecrt_slave_config_create_sdo_request(
+                    sc, sdo_index, sdo_subindex, 4);
+            if (!requests[request_count]) {
+                return -1;
+            }
+            request_count++;
+        }
+    }
+
+    printf("Activating master...\n");
+    if (ecrt_master_activate(master)) {
+        return -1;
+    }
+
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    printf("Using priority %i.\n", param.sched_priority);
+    if (sched_setscheduler(0, SCHED_FIFO, &param) == -1) {
+        perror("sched_setscheduler failed");
+    }
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1) {
+        fprintf(stderr, "Warning: Failed to lock memory: %s\n",
+                strerror(errno));
+    }
+
+    stack_prefault();
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    printf("Starting RT task with dt=%u us, %u slaves with %u requests"
+            " for 0x%04X:%02X.\n", period_us, slave_count, per_slave,
+            sdo_index, sdo_subindex);
+
+    clock_gettime(CLOCK_MONOTONIC, &wakeup_time);
+    wakeup_time.tv_sec += 1; /* start in future */
+    wakeup_time.tv_nsec = 0;
+
+    while (run) {
+        ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+                &wakeup_time, NULL);
+        if (ret) {
+            if (ret == EINTR) {
+                ret = 0;
+                continue;
+            }
+            fprintf(stderr, "clock_nanosleep(): %s\n", strerror(ret));
+            break;
+        }
+
+        cyclic_task();
+
+        if (++counter * period_us >= 1000000) { // once per second
+            printf("%5u s: %lu uploads/s (%.1f per slave), state max"
+                    " %7.3f us, read max %7.3f us\n", ++elapsed,
+                    completed - last_completed,
+                    (double) (completed - last_completed) / slave_count,
+                    state_stats.max_ns / 1000.0,
+                    read_stats.max_ns / 1000.0);
+            last_completed = completed;
+            counter = 0;
+
+            if (seconds && elapsed >= seconds) {
+                break;
+            }
+        }
+
+        wakeup_time.tv_nsec += period_us * 1000;
+        while (wakeup_time.tv_nsec >= NSEC_PER_SEC) {
+            wakeup_time.tv_nsec -= NSEC_PER_SEC;
+            wakeup_time.tv_sec++;
+        }
+    }
+
+    printf("%lu uploads completed, %lu failed", completed, errors);
+    if (elapsed) {
+        printf(", %.1f uploads/s per slave",
+                (double) completed / elapsed / slave_count);
+    }
+    printf(".\n");
+    print_timing("state", &state_stats);
+    print_timing("read", &read_stats);
+
+    ecrt_release_master(master);
+    return ret;
+}
+
+/****************************************************************************/
@@ -195,6 +195,25 @@
  */
 #define EC_HAVE_SYNC_TO
 
+/** Defined if the method ecrt_master_cycle() is available.
+ */
+#define EC_HAVE_CYCLE
+
+/** Defined if the methods ecrt_master_event_fd(), ecrt_master_events() and
+ * ecrt_master_bind_eventfd() are available (userspace only).
+ */
+#define EC_HAVE_EVENTS
+
+/** Defined if the method ecrt_slave_config_reg_esc_registers() is available.
+ */
+#define EC_HAVE_REG_ESC
+
+/** Defined if the methods ecrt_foe_request_stream_write(),
+ * ecrt_foe_request_stream_read(), ecrt_foe_request_stream_push() and
+ * ecrt_foe_request_stream_pull() are available.
+ */
+#define EC_HAVE_FOE_STREAM
+
 /*****************************************************************************/
 
 /** End of list marker.
@@ -431,6 +450,66 @@ typedef struct {
 
 /*****************************************************************************/
 
+/** Master events.
+ *
+ * \see ecrt_master_event_fd().
+ */
+enum {
+    EC_EVENT_REQUEST = 0x01, /**< A request of the application
+                               completed. */
+    EC_EVENT_EMERGENCY = 0x02, /**< A CoE emergency message was stored in
+                                 the ring of a slave configuration. */
+    EC_EVENT_AL_STATE = 0x04, /**< The AL state of a slave changed. */
+    EC_EVENT_TOPOLOGY = 0x08, /**< The bus topology or a link state changed,
+                                or a bus scan finished. */
+    EC_EVENT_ALL = 0x0f /**< All events. */
+};
+
+/*****************************************************************************/
+
+/** Operations of ecrt_master_cycle().
+ *
+ * The operations are executed in the order of their values.
+ */
+enum {
+    EC_CYCLE_RECEIVE = 0x0001, /**< ecrt_master_receive(). */
+    EC_CYCLE_PROCESS = 0x0002, /**< ecrt_domain_process() and
+                                 ecrt_domain_state() for all domains. */
+    EC_CYCLE_APP_TIME = 0x0004, /**< ecrt_master_application_time() with
+                                  \a app_time. */
+    EC_CYCLE_SYNC_REF = 0x0008, /**< ecrt_master_sync_reference_clock(). */
+    EC_CYCLE_SYNC_REF_TO = 0x0010, /**< ecrt_master_sync_reference_clock_to()
+                                     with \a sync_time. */
+    EC_CYCLE_SYNC_SLAVES = 0x0020, /**< ecrt_master_sync_slave_clocks(). */
+    EC_CYCLE_SYNC_MON = 0x0040, /**< ecrt_master_sync_monitor_queue(). */
+    EC_CYCLE_QUEUE = 0x0080, /**< ecrt_domain_queue() for all domains. */
+    EC_CYCLE_SEND = 0x0100 /**< ecrt_master_send(). */
+};
+
+/** Domain entry of an ec_cycle_t.
+ */
+typedef struct {
+    ec_domain_t *domain; /**< Domain to process and/or queue. */
+    ec_domain_state_t state; /**< Domain state after processing (only
+                               written with \a EC_CYCLE_PROCESS). */
+} ec_cycle_domain_t;
+
+/** Descriptor of a batched cyclic operation.
+ *
+ * This is used for ecrt_master_cycle().
+ */
+typedef struct {
+    unsigned int operations; /**< Bitwise OR of \a EC_CYCLE_* values. */
+    uint64_t app_time; /**< Application time for \a EC_CYCLE_APP_TIME. */
+    uint64_t sync_time; /**< Reference clock time for
+                          \a EC_CYCLE_SYNC_REF_TO. */
+    ec_cycle_domain_t *domains; /**< Domains to process and queue. */
+    unsigned int domain_count; /**< Number of entries in \a domains. */
+    size_t sent_bytes; /**< Bytes sent (output of \a EC_CYCLE_SEND). */
+} ec_cycle_t;
+
+/*****************************************************************************/
+
 /** Direction type for PDO assignment functions.
  */
 typedef enum {
@@ -1167,6 +1246,60 @@ int ecrt_master_link_state(
                                        */
         );
 
+#ifndef __KERNEL__
+
+/** Selects the master events to wait for.
+ *
+ * Returns a file descriptor, that can be passed to poll(), select() or
+ * epoll. It becomes readable, if one of the selected \a EC_EVENT_* events
+ * occurred since the pending events were last acknowledged with
+ * ecrt_master_events(). Selecting the events acknowledges all pending
+ * events. All events are selected by default.
+ *
+ * The file descriptor belongs to the master and must neither be read nor
+ * closed by the application.
+ *
+ * Request completions (\a EC_EVENT_REQUEST) are only signalled for
+ * requests of an activated master.
+ *
+ * \return File descriptor on success, otherwise negative error code.
+ */
+int ecrt_master_event_fd(
+        ec_master_t *master, /**< EtherCAT master. */
+        unsigned int events /**< Bitwise OR of \a EC_EVENT_* values. */
+        );
+
+/** Gets and acknowledges the pending master events.
+ *
+ * The events themselves carry no further information. Use the state
+ * methods (like ecrt_sdo_request_state(), ecrt_slave_config_emerg_pop()
+ * or ecrt_master_state()) to find out what happened.
+ *
+ * \return Bitwise OR of the pending and selected \a EC_EVENT_* values on
+ * success, otherwise negative error code.
+ */
+int ecrt_master_events(
+        ec_master_t *master /**< EtherCAT master. */
+        );
+
+/** Binds master events to an eventfd.
+ *
+ * The master signals the eventfd (adds one to its counter), each time one
+ * of the given \a EC_EVENT_* events occurs. This is independent of the
+ * events selected with ecrt_master_event_fd(). Only one eventfd can be bound
+ * per master handle; binding a new one or passing -1 as \a fd releases the
+ * previous binding.
+ *
+ * \return 0 on success, otherwise negative error code.
+ */
+int ecrt_master_bind_eventfd(
+        ec_master_t *master, /**< EtherCAT master. */
+        int fd, /**< eventfd file descriptor, or -1 to unbind. */
+        unsigned int events /**< Bitwise OR of \a EC_EVENT_* values. */
+        );
+
+#endif // #ifndef __KERNEL__
+
 /** Sets the application time.
  *
  * The master has to know the application's time when operating slaves with
@@ -1289,6 +1422,28 @@ uint32_t ecrt_master_sync_monitor_process(
         ec_master_t *master /**< EtherCAT master. */
         );
 
+/** Executes several cyclic operations at once.
+ *
+ * This executes the operations selected in \a cycle->operations in the
+ * order of the \a EC_CYCLE_* values, i. e. receiving, processing the domains
+ * in \a cycle->domains and storing their states, the distributed clocks
+ * operations, queueing the domains and sending. For userspace applications,
+ * this needs only one system call instead of one per operation and domain.
+ *
+ * \attention Received frames are written into the process data memory, so
+ * outputs have to be written between processing and queueing. A cyclic task
+ * therefore usually calls this method twice per cycle: Once at the beginning
+ * with \a EC_CYCLE_RECEIVE and \a EC_CYCLE_PROCESS, and once at the end with
+ * the distributed clocks operations, \a EC_CYCLE_QUEUE and \a EC_CYCLE_SEND.
+ *
+ * \return 0 on success, otherwise negative error code (-EINVAL, if
+ *         \a cycle->operations contains unknown bits).
+ */
+int ecrt_master_cycle(
+        ec_master_t *master, /**< EtherCAT master. */
+        ec_cycle_t *cycle /**< Cycle descriptor. */
+        );
+
 /** Selects whether to process slave requests by the application or the master
  *
  * if rt_slave_requests \a True, slave requests are to be handled by calls to 
@@ -1572,6 +1727,32 @@ int ecrt_slave_config_reg_pdo_entry_pos(
                                  is desired */
         );
 
+/** Registers a range of ESC registers for cyclic reading in a domain.
+ *
+ * Maps the given range of the slave's EtherCAT slave controller registers
+ * into the domain's process image via an additional FMMU. Diagnostic
+ * registers like the AL status (\p 0x0130), the DC system time difference
+ * (\p 0x092C) or the error counters (\p 0x0300 - \p 0x0313) are then
+ * transferred with the cyclic process data frame, without the need for
+ * separate register requests. The range is read-only and counts to the
+ * domain's working counter like an input.
+ *
+ * A range that is already covered by a registered range of the same slave
+ * configuration and domain does not occupy a new FMMU.
+ *
+ * This method has to be called in non-realtime context before
+ * ecrt_master_activate().
+ *
+ * \retval >=0 Success: Offset of the register data in the process image.
+ * \retval  <0 Error code.
+ */
+int ecrt_slave_config_reg_esc_registers(
+        ec_slave_config_t *sc, /**< Slave configuration. */
+        uint16_t address, /**< Register address. */
+        uint16_t size, /**< Size of the register range in byte. */
+        ec_domain_t *domain /**< Domain. */
+        );
+
 /** Configure distributed clocks.
  *
  * Sets the AssignActivate word and the cycle and shift times for the sync
@@ -2250,6 +2431,69 @@ void ecrt_foe_request_read(
         ec_foe_request_t *req /**< FoE request. */
         );
 
+/** Schedule a streamed FoE write operation.
+ *
+ * In contrast to ecrt_foe_request_write(), the file does not have to fit
+ * into the request's memory. The memory is used as a ring buffer instead,
+ * that is filled with ecrt_foe_request_stream_push() while the transfer is
+ * running. The transfer waits for data, if the ring buffer runs empty.
+ *
+ * The memory size specified in ecrt_slave_config_create_foe_request() must
+ * at least hold one mailbox fragment.
+ *
+ * \attention This method may not be called while ecrt_foe_request_state()
+ * returns EC_REQUEST_BUSY.
+ */
+void ecrt_foe_request_stream_write(
+        ec_foe_request_t *req /**< FoE request. */
+        );
+
+/** Schedule a streamed FoE read operation.
+ *
+ * The received file data are placed into the request's memory, which is
+ * used as a ring buffer, and have to be taken with
+ * ecrt_foe_request_stream_pull() while the transfer is running. The
+ * transfer waits for the application, if the ring buffer is full.
+ *
+ * ecrt_foe_request_progress() returns the number of bytes received so far.
+ *
+ * \attention This method may not be called while ecrt_foe_request_state()
+ * returns EC_REQUEST_BUSY.
+ */
+void ecrt_foe_request_stream_read(
+        ec_foe_request_t *req /**< FoE request. */
+        );
+
+/** Pass file data to a streamed FoE write operation.
+ *
+ * The data are copied into the free part of the ring buffer. The method does
+ * not block, so less data than requested may be accepted. The remainder has
+ * to be passed again later.
+ *
+ * \return Number of bytes accepted.
+ */
+size_t ecrt_foe_request_stream_push(
+        ec_foe_request_t *req, /**< FoE request. */
+        const uint8_t *data, /**< File data. */
+        size_t size, /**< Number of bytes in \a data. */
+        int last /**< Non-zero, if \a data end the file. The end is only
+                   marked, if all bytes were accepted. */
+        );
+
+/** Take file data from a streamed FoE read operation.
+ *
+ * The method does not block. Data can still be taken after
+ * ecrt_foe_request_state() returned EC_REQUEST_SUCCESS, until zero is
+ * returned.
+ *
+ * \return Number of bytes copied to \a data.
+ */
+size_t ecrt_foe_request_stream_pull(
+        ec_foe_request_t *req, /**< FoE request. */
+        uint8_t *data, /**< Target memory. */
+        size_t size /**< Size of \a data. */
+        );
+
 /*****************************************************************************
  * VoE handler methods.
  ****************************************************************************/
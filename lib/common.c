@@ -85,6 +85,13 @@ ec_master_t *ecrt_open_master(unsigned int master_index)
     master->process_data_size = 0;
     master->first_domain = NULL;
     master->first_config = NULL;
+    master->cycle_domains = NULL;
+    master->cycle_domain_count = 0;
+    master->status = NULL;
+    master->status_size = 0;
+    master->ring = NULL;
+    master->ring_size = 0;
+    master->ring_busy = 0;
 
     snprintf(path, MAX_PATH_LEN - 1,
 #if defined(USE_RTDM)
@@ -140,9 +140,19 @@ void ecrt_domain_queue(ec_domain_t *domain)
 
 void ecrt_domain_state(const ec_domain_t *domain, ec_domain_state_t *state)
 {
+    const ec_ioctl_status_t *status = domain->master->status;
     ec_ioctl_domain_state_t data;
     int ret;
 
+    if (status && domain->index < status->domain_count) {
+        const ec_ioctl_status_domain_t *entry =
+            EC_IOCTL_STATUS_DOMAINS(status) + domain->index;
+        if (!ec_master_read_status(domain->master, &entry->sequence, state,
+                    &entry->state, sizeof(*state))) {
+            return;
+        }
+    }
+
     data.domain_index = domain->index;
     data.state = state;
 
@@ -119,8 +119,19 @@ size_t ecrt_foe_request_progress(const ec_foe_request_t *req)
 ec_request_state_t ecrt_foe_request_state(ec_foe_request_t *req)
 {
     ec_ioctl_foe_request_t data;
+    ec_request_state_t state;
     int ret;
 
+    // the request ring does not reflect streamed transfers
+    if (req->ring.entry && !req->ring.bypassed && !req->stream) {
+        state = ec_request_ring_state(req->config->master, &req->ring,
+                req->data, req->mem_size, &req->data_size);
+        req->progress = req->ring.entry->progress;
+        req->result = req->ring.entry->result;
+        req->error_code = req->ring.entry->error_code;
+        return state;
+    }
+
     data.config_index = req->config->index;
     data.request_index = req->index;
 
@@ -177,6 +188,13 @@ void ecrt_foe_request_read(ec_foe_request_t *req)
     ec_ioctl_foe_request_t data;
     int ret;
 
+    req->stream = 0;
+
+    if (req->ring.entry && !ec_request_ring_submit(req->config->master,
+                &req->ring, EC_IOCTL_RING_READ, 0, NULL, 0)) {
+        return; // otherwise started via ioctl()
+    }
+
     data.config_index = req->config->index;
     data.request_index = req->index;
 
@@ -194,6 +212,13 @@ void ecrt_foe_request_write(ec_foe_request_t *req, size_t size)
     ec_ioctl_foe_request_t data;
     int ret;
 
+    req->stream = 0;
+
+    if (req->ring.entry && !ec_request_ring_submit(req->config->master,
+                &req->ring, EC_IOCTL_RING_WRITE, 0, req->data, size)) {
+        return; // otherwise started via ioctl()
+    }
+
     data.config_index = req->config->index;
     data.request_index = req->index;
     data.data = req->data;
@@ -207,3 +232,89 @@ void ecrt_foe_request_write(ec_foe_request_t *req, size_t size)
 }
 
 /*****************************************************************************/
+
+static void ec_foe_request_stream(ec_foe_request_t *req, uint8_t dir)
+{
+    ec_ioctl_foe_request_t data;
+    int ret;
+
+    data.config_index = req->config->index;
+    data.request_index = req->index;
+    data.dir = dir;
+
+    ret = ioctl(req->config->master->fd, EC_IOCTL_FOE_REQUEST_STREAM, &data);
+    if (EC_IOCTL_IS_ERROR(ret)) {
+        fprintf(stderr, "Failed to command a streamed FoE operation: %s\n",
+                strerror(EC_IOCTL_ERRNO(ret)));
+        return;
+    }
+
+    req->stream = 1;
+    req->data_size = 0;
+    req->progress = 0;
+}
+
+/*****************************************************************************/
+
+void ecrt_foe_request_stream_write(ec_foe_request_t *req)
+{
+    ec_foe_request_stream(req, EC_DIR_OUTPUT);
+}
+
+/*****************************************************************************/
+
+void ecrt_foe_request_stream_read(ec_foe_request_t *req)
+{
+    ec_foe_request_stream(req, EC_DIR_INPUT);
+}
+
+/*****************************************************************************/
+
+size_t ecrt_foe_request_stream_push(ec_foe_request_t *req,
+        const uint8_t *data, size_t size, int last)
+{
+    ec_ioctl_foe_request_t io;
+    int ret;
+
+    io.config_index = req->config->index;
+    io.request_index = req->index;
+    io.data = (uint8_t *) data;
+    io.size = size;
+    io.last = last ? 1 : 0;
+
+    ret = ioctl(req->config->master->fd,
+            EC_IOCTL_FOE_REQUEST_STREAM_DATA, &io);
+    if (EC_IOCTL_IS_ERROR(ret)) {
+        fprintf(stderr, "Failed to push FoE stream data: %s\n",
+                strerror(EC_IOCTL_ERRNO(ret)));
+        return 0;
+    }
+
+    return io.size;
+}
+
+/*****************************************************************************/
+
+size_t ecrt_foe_request_stream_pull(ec_foe_request_t *req,
+        uint8_t *data, size_t size)
+{
+    ec_ioctl_foe_request_t io;
+    int ret;
+
+    io.config_index = req->config->index;
+    io.request_index = req->index;
+    io.data = data;
+    io.size = size;
+
+    ret = ioctl(req->config->master->fd,
+            EC_IOCTL_FOE_REQUEST_STREAM_DATA, &io);
+    if (EC_IOCTL_IS_ERROR(ret)) {
+        fprintf(stderr, "Failed to pull FoE stream data: %s\n",
+                strerror(EC_IOCTL_ERRNO(ret)));
+        return 0;
+    }
+
+    return io.size;
+}
+
+/*****************************************************************************/
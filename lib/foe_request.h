@@ -30,6 +30,7 @@
  *****************************************************************************/
 
 #include "include/ecrt.h"
+#include "request_ring.h"
 
 /*****************************************************************************/
 
@@ -43,6 +44,8 @@ struct ec_foe_request {
     size_t progress; /**< Current position of a BUSY request. */
     ec_foe_error_t result; /**< FoE request abort code. Zero on success. */
     uint32_t error_code; /**< Error code from an FoE Error Request. */
+    int stream; /**< A streamed transfer was scheduled. */
+    ec_request_ring_ref_t ring; /**< Request ring reference. */
 };
 
 /*****************************************************************************/
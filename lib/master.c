@@ -37,6 +37,7 @@
 #include "master.h"
 #include "domain.h"
 #include "slave_config.h"
+#include "request_ring.h"
 
 /****************************************************************************/
 
@@ -81,6 +82,24 @@ void ec_master_clear_config(ec_master_t *master)
     }
     master->first_config = NULL;
 
+    if (master->cycle_domains) {
+        free(master->cycle_domains);
+        master->cycle_domains = NULL;
+        master->cycle_domain_count = 0;
+    }
+
+    if (master->ring) {
+        munmap(master->ring, master->ring_size);
+        master->ring = NULL;
+        master->ring_size = 0;
+    }
+
+    if (master->status) {
+        munmap((void *) master->status, master->status_size);
+        master->status = NULL;
+        master->status_size = 0;
+    }
+
     if (master->process_data)  {
         munmap(master->process_data, master->process_data_size);
         master->process_data = NULL;
@@ -88,6 +107,54 @@ void ec_master_clear_config(ec_master_t *master)
     }
 }
 
+/*****************************************************************************/
+
+/** Maximum number of attempts to read a consistent snapshot from the status
+ * page.
+ *
+ * The reader must not spin on the sequence number, because a preempted
+ * writer would never finish while a higher-prioritized reader is waiting.
+ */
+#define EC_STATUS_READ_ATTEMPTS 3
+
+/** Copies a region of the status page, that is protected by a sequence
+ * number.
+ *
+ * \return Zero on success, or -EAGAIN, if no consistent snapshot could be
+ * read. In that case, the caller shall fall back to the ioctl().
+ */
+int ec_master_read_status(
+        const ec_master_t *master, /**< EtherCAT master. */
+        const uint32_t *sequence, /**< Sequence number of the region. */
+        void *dest, /**< Destination buffer. */
+        const void *src, /**< Region in the status page. */
+        size_t size /**< Size of the region. */
+        )
+{
+    const volatile uint32_t *seq = sequence;
+    unsigned int attempt;
+    uint32_t start;
+
+    if (!master->status) {
+        return -ENODEV;
+    }
+
+    for (attempt = 0; attempt < EC_STATUS_READ_ATTEMPTS; attempt++) {
+        start = *seq;
+        if (start & 1) { // update in progress
+            continue;
+        }
+        __sync_synchronize(); // sequence before the contents
+        memcpy(dest, src, size);
+        __sync_synchronize(); // contents before the sequence
+        if (*seq == start) {
+            return 0;
+        }
+    }
+
+    return -EAGAIN;
+}
+
 /****************************************************************************/
 
 void ec_master_clear(ec_master_t *master)
@@ -616,6 +683,48 @@ int ecrt_master_setup_domain_memory(ec_master_t *master)
 
 /*****************************************************************************/
 
+#if !defined(USE_RTDM) && !defined(USE_RTDM_XENOMAI_V3)
+
+/** Maps the status page and the request ring reported by EC_IOCTL_ACTIVATE.
+ *
+ * Both are optional: If a mapping fails, the states are read and the
+ * requests are handled via ioctl() instead.
+ */
+static void ec_master_map_shared(
+        ec_master_t *master, /**< EtherCAT master. */
+        const ec_ioctl_master_activate_t *io /**< Activation results. */
+        )
+{
+    if (io->status_size) {
+        void *status = mmap(0, io->status_size, PROT_READ, MAP_SHARED,
+                master->fd, EC_IOCTL_STATUS_OFFSET);
+        if (status == MAP_FAILED) {
+            EC_PRINT_ERR("Failed to map status page: %s\n",
+                    strerror(errno));
+        } else {
+            master->status = status;
+            master->status_size = io->status_size;
+        }
+    }
+
+    if (io->ring_size) {
+        void *ring = mmap(0, io->ring_size, PROT_READ | PROT_WRITE,
+                MAP_SHARED, master->fd, EC_IOCTL_RING_OFFSET);
+        if (ring == MAP_FAILED) {
+            EC_PRINT_ERR("Failed to map request ring: %s\n",
+                    strerror(errno));
+        } else {
+            master->ring = ring;
+            master->ring_size = io->ring_size;
+            ec_request_ring_attach(master);
+        }
+    }
+}
+
+#endif
+
+/*****************************************************************************/
+
 int ecrt_master_activate(ec_master_t *master)
 {
     ec_ioctl_master_activate_t io;
@@ -653,6 +762,10 @@ int ecrt_master_activate(ec_master_t *master)
         master->process_data[0] = 0x00;
     }
 
+#if !defined(USE_RTDM) && !defined(USE_RTDM_XENOMAI_V3)
+    ec_master_map_shared(master, &io);
+#endif
+
     return 0;
 }
 
@@ -828,6 +941,12 @@ void ecrt_master_state(const ec_master_t *master, ec_master_state_t *state)
 {
     int ret;
 
+    if (master->status && !ec_master_read_status(master,
+                &master->status->sequence, state,
+                &master->status->master_state, sizeof(*state))) {
+        return;
+    }
+
     ret = ioctl(master->fd, EC_IOCTL_MASTER_STATE, state);
     if (EC_IOCTL_IS_ERROR(ret)) {
         EC_PRINT_ERR("Failed to get master state: %s\n",
@@ -843,6 +962,13 @@ int ecrt_master_link_state(const ec_master_t *master, unsigned int dev_idx,
     ec_ioctl_link_state_t io;
     int ret;
 
+    if (master->status && dev_idx < master->status->device_count
+            && !ec_master_read_status(master, &master->status->sequence,
+                state, &master->status->link_states[dev_idx],
+                sizeof(*state))) {
+        return 0;
+    }
+
     io.dev_idx = dev_idx;
     io.state = state;
 
@@ -858,6 +984,67 @@ int ecrt_master_link_state(const ec_master_t *master, unsigned int dev_idx,
 
 /****************************************************************************/
 
+int ecrt_master_event_fd(ec_master_t *master, unsigned int events)
+{
+    ec_ioctl_events_t io;
+    int ret;
+
+    io.select = 1;
+    io.events = events;
+
+    ret = ioctl(master->fd, EC_IOCTL_EVENTS, &io);
+    if (EC_IOCTL_IS_ERROR(ret)) {
+        EC_PRINT_ERR("Failed to select master events: %s\n",
+                strerror(EC_IOCTL_ERRNO(ret)));
+        return -EC_IOCTL_ERRNO(ret);
+    }
+
+    return master->fd;
+}
+
+/****************************************************************************/
+
+int ecrt_master_events(ec_master_t *master)
+{
+    ec_ioctl_events_t io;
+    int ret;
+
+    io.select = 0;
+    io.events = 0;
+
+    ret = ioctl(master->fd, EC_IOCTL_EVENTS, &io);
+    if (EC_IOCTL_IS_ERROR(ret)) {
+        EC_PRINT_ERR("Failed to get master events: %s\n",
+                strerror(EC_IOCTL_ERRNO(ret)));
+        return -EC_IOCTL_ERRNO(ret);
+    }
+
+    return io.pending;
+}
+
+/****************************************************************************/
+
+int ecrt_master_bind_eventfd(ec_master_t *master, int fd,
+        unsigned int events)
+{
+    ec_ioctl_eventfd_t io;
+    int ret;
+
+    io.fd = fd;
+    io.events = events;
+
+    ret = ioctl(master->fd, EC_IOCTL_EVENTFD, &io);
+    if (EC_IOCTL_IS_ERROR(ret)) {
+        EC_PRINT_ERR("Failed to bind eventfd: %s\n",
+                strerror(EC_IOCTL_ERRNO(ret)));
+        return -EC_IOCTL_ERRNO(ret);
+    }
+
+    return 0;
+}
+
+/****************************************************************************/
+
 void ecrt_master_application_time(ec_master_t *master, uint64_t app_time)
 {
     uint64_t time;
@@ -1007,6 +1194,56 @@ uint32_t ecrt_master_sync_monitor_process(ec_master_t *master)
 
 /****************************************************************************/
 
+int ecrt_master_cycle(ec_master_t *master, ec_cycle_t *cycle)
+{
+    ec_ioctl_cycle_t io;
+    unsigned int i;
+    int ret;
+
+    if (cycle->domain_count > master->cycle_domain_count) {
+        /* only reallocated, if the application passes more domains than
+         * before, so usually only in the first cycle. */
+        ec_ioctl_cycle_domain_t *domains = realloc(master->cycle_domains,
+                cycle->domain_count * sizeof(ec_ioctl_cycle_domain_t));
+        if (!domains) {
+            EC_PRINT_ERR("Failed to allocate memory.\n");
+            return -ENOMEM;
+        }
+        master->cycle_domains = domains;
+        master->cycle_domain_count = cycle->domain_count;
+    }
+
+    for (i = 0; i < cycle->domain_count; i++) {
+        master->cycle_domains[i].domain_index =
+            cycle->domains[i].domain->index;
+    }
+
+    io.operations = cycle->operations;
+    io.app_time = cycle->app_time;
+    io.sync_time = cycle->sync_time;
+    io.domain_count = cycle->domain_count;
+    io.domains = master->cycle_domains;
+    io.sent_bytes = 0;
+
+    ret = ioctl(master->fd, EC_IOCTL_CYCLE, &io);
+    if (EC_IOCTL_IS_ERROR(ret)) {
+        EC_PRINT_ERR("Failed to execute cycle: %s\n",
+                strerror(EC_IOCTL_ERRNO(ret)));
+        return -EC_IOCTL_ERRNO(ret);
+    }
+
+    if (cycle->operations & EC_CYCLE_PROCESS) {
+        for (i = 0; i < cycle->domain_count; i++) {
+            cycle->domains[i].state = master->cycle_domains[i].state;
+        }
+    }
+
+    cycle->sent_bytes = io.sent_bytes;
+    return 0;
+}
+
+/****************************************************************************/
+
 int ecrt_master_rt_slave_requests(ec_master_t *master,
         unsigned int rt_slave_requests)
 {
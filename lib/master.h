@@ -29,6 +29,7 @@
  *****************************************************************************/
 
 #include "include/ecrt.h"
+#include "ioctl.h"
 
 /*****************************************************************************/
 
@@ -39,10 +40,22 @@ struct ec_master {
 
     ec_domain_t *first_domain;
     ec_slave_config_t *first_config;
+
+    ec_ioctl_cycle_domain_t *cycle_domains;
+    unsigned int cycle_domain_count;
+
+    const ec_ioctl_status_t *status;
+    size_t status_size;
+
+    ec_ioctl_ring_t *ring;
+    size_t ring_size;
+    int ring_busy;
 };
 
 /*****************************************************************************/
 
 void ec_master_clear(ec_master_t *);
+int ec_master_read_status(const ec_master_t *, const uint32_t *, void *,
+        const void *, size_t);
 
 /*****************************************************************************/
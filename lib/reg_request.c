@@ -64,8 +64,14 @@ uint8_t *ecrt_reg_request_data(ec_reg_request_t *reg)
 ec_request_state_t ecrt_reg_request_state(ec_reg_request_t *reg)
 {
     ec_ioctl_reg_request_t io;
+    size_t data_size;
     int ret;
 
+    if (reg->ring.entry && !reg->ring.bypassed) {
+        return ec_request_ring_state(reg->config->master, &reg->ring,
+                reg->data, reg->mem_size, &data_size);
+    }
+
     io.config_index = reg->config->index;
     io.request_index = reg->index;
 
@@ -101,6 +107,12 @@ void ecrt_reg_request_write(ec_reg_request_t *reg, uint16_t address,
     ec_ioctl_reg_request_t io;
     int ret;
 
+    if (reg->ring.entry && !ec_request_ring_submit(reg->config->master,
+                &reg->ring, EC_IOCTL_RING_WRITE, address, reg->data,
+                size)) {
+        return; // otherwise started via ioctl()
+    }
+
     io.config_index = reg->config->index;
     io.request_index = reg->index;
     io.data = reg->data;
@@ -122,6 +134,11 @@ void ecrt_reg_request_read(ec_reg_request_t *reg, uint16_t address,
     ec_ioctl_reg_request_t io;
     int ret;
 
+    if (reg->ring.entry && !ec_request_ring_submit(reg->config->master,
+                &reg->ring, EC_IOCTL_RING_READ, address, NULL, size)) {
+        return; // otherwise started via ioctl()
+    }
+
     io.config_index = reg->config->index;
     io.request_index = reg->index;
     io.address = address;
@@ -142,6 +159,12 @@ void ecrt_reg_request_readwrite(ec_reg_request_t *reg, uint16_t address,
     ec_ioctl_reg_request_t io;
     int ret;
 
+    if (reg->ring.entry && !ec_request_ring_submit(reg->config->master,
+                &reg->ring, EC_IOCTL_RING_READWRITE, address, reg->data,
+                size)) {
+        return; // otherwise started via ioctl()
+    }
+
     io.config_index = reg->config->index;
     io.request_index = reg->index;
     io.data = reg->data;
@@ -29,6 +29,7 @@
  *****************************************************************************/
 
 #include "include/ecrt.h"
+#include "request_ring.h"
 
 /*****************************************************************************/
 
@@ -38,6 +39,7 @@ struct ec_reg_request {
     unsigned int index; /**< Request index (identifier). */
     uint8_t *data; /**< Data memory. */
     size_t mem_size; /**< Size of \a data. */
+    ec_request_ring_ref_t ring; /**< Request ring reference. */
 };
 
 /*****************************************************************************/
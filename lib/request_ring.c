@@ -0,0 +1,245 @@
+/******************************************************************************
+ *
+ *  $Id$
+ *
+ *  Copyright (C) 2006-2009  Florian Pose, Ingenieurgemeinschaft IgH
+ *
+ *  This file is part of the IgH EtherCAT master userspace library.
+ *
+ *  The IgH EtherCAT master userspace library is free software; you can
+ *  redistribute it and/or modify it under the terms of the GNU Lesser General
+ *  Public License as published by the Free Software Foundation; version 2.1
+ *  of the License.
+ *
+ *  The IgH EtherCAT master userspace library is distributed in the hope that
+ *  it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the IgH EtherCAT master userspace library. If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ *  ---
+ *
+ *  The license mentioned above concerns the source code only. Using the
+ *  EtherCAT technology and brand is only permitted in compliance with the
+ *  industrial property and similar rights of Beckhoff Automation GmbH.
+ *
+ *****************************************************************************/
+
+/** \file
+ * Request ring functions.
+ *
+ * The request ring is a memory-mapped submission ring shared with the
+ * master. SDO, register and FoE requests are started and polled via the
+ * ring without calling ioctl(). If the ring is full or another thread is
+ * submitting at the same time, the request is started via ioctl() instead.
+ */
+
+/*****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include "request_ring.h"
+#include "master.h"
+#include "slave_config.h"
+#include "sdo_request.h"
+#include "reg_request.h"
+#include "foe_request.h"
+
+/*****************************************************************************/
+
+void ec_request_ring_ref_init(ec_request_ring_ref_t *ref)
+{
+    ref->entry = NULL;
+    ref->sequence = 0;
+    ref->fetched = 0;
+    ref->bypassed = 0;
+}
+
+/*****************************************************************************/
+
+/** Attaches a request to its ring entry.
+ */
+static void ec_request_ring_attach_ref(
+        ec_request_ring_ref_t *ref, /**< Request ring reference. */
+        const ec_ioctl_ring_entry_t *entry /**< Request entry. */
+        )
+{
+    ref->entry = entry;
+    ref->sequence = entry->sequence;
+    ref->fetched = 1;
+    ref->bypassed = 0;
+}
+
+/*****************************************************************************/
+
+/** Attaches the requests of all slave configurations to the entries of the
+ * mapped request ring.
+ */
+void ec_request_ring_attach(ec_master_t *master)
+{
+    const ec_ioctl_ring_entry_t *entry = EC_IOCTL_RING_ENTRIES(master->ring);
+    ec_slave_config_t *sc;
+    ec_sdo_request_t *sdo;
+    ec_reg_request_t *reg;
+    ec_foe_request_t *foe;
+    unsigned int i;
+
+    for (i = 0; i < master->ring->entry_count; i++, entry++) {
+        for (sc = master->first_config; sc; sc = sc->next) {
+            if (sc->index == entry->config_index) {
+                break;
+            }
+        }
+        if (!sc) {
+            continue;
+        }
+
+        switch (entry->type) {
+            case EC_IOCTL_RING_SDO:
+                for (sdo = sc->first_sdo_request; sdo; sdo = sdo->next) {
+                    if (sdo->index == entry->request_index) {
+                        ec_request_ring_attach_ref(&sdo->ring, entry);
+                        break;
+                    }
+                }
+                break;
+            case EC_IOCTL_RING_REG:
+                for (reg = sc->first_reg_request; reg; reg = reg->next) {
+                    if (reg->index == entry->request_index) {
+                        ec_request_ring_attach_ref(&reg->ring, entry);
+                        break;
+                    }
+                }
+                break;
+            case EC_IOCTL_RING_FOE:
+                for (foe = sc->first_foe_request; foe; foe = foe->next) {
+                    if (foe->index == entry->request_index) {
+                        ec_request_ring_attach_ref(&foe->ring, entry);
+                        break;
+                    }
+                }
+                break;
+        }
+    }
+}
+
+/*****************************************************************************/
+
+/** Submits a request operation to the request ring.
+ *
+ * The master starts the operation in its next cycle. The submission slot is
+ * claimed via a try-lock, so that several threads can submit requests
+ * without waiting for each other: If the ring is in use by another thread,
+ * full, or the data do not fit into the entry memory, the request is marked
+ * as bypassed and the caller has to start it via ioctl().
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+int ec_request_ring_submit(
+        ec_master_t *master, /**< EtherCAT master. */
+        ec_request_ring_ref_t *ref, /**< Request ring reference. */
+        unsigned int command, /**< Command (EC_IOCTL_RING_READ, ...). */
+        uint16_t address, /**< Register address. */
+        const uint8_t *data, /**< Data to write, or NULL. */
+        size_t size /**< Transfer size. */
+        )
+{
+    volatile ec_ioctl_ring_t *ring = master->ring;
+    ec_ioctl_ring_sub_t *sub;
+    uint32_t head;
+
+    if (size > ref->entry->mem_size) {
+        ref->bypassed = 1;
+        return -EOVERFLOW;
+    }
+
+    if (__sync_lock_test_and_set(&master->ring_busy, 1)) {
+        ref->bypassed = 1;
+        return -EBUSY;
+    }
+
+    head = ring->sub_head;
+    if (head - ring->sub_tail >= ring->sub_count) {
+        __sync_lock_release(&master->ring_busy);
+        ref->bypassed = 1;
+        return -EAGAIN;
+    }
+
+    __sync_synchronize(); // released slot before it is overwritten
+
+    if (data) {
+        memcpy((uint8_t *) master->ring + ref->entry->data_offset, data,
+                size);
+    }
+
+    sub = EC_IOCTL_RING_SUBS(master->ring)
+        + (head & (master->ring->sub_count - 1));
+    sub->entry = ref->entry - EC_IOCTL_RING_ENTRIES(master->ring);
+    sub->command = command;
+    sub->address = address;
+    sub->size = size;
+
+    __sync_synchronize(); // submission before the head
+    ring->sub_head = head + 1;
+    __sync_lock_release(&master->ring_busy);
+
+    ref->sequence++;
+    ref->fetched = 0;
+    ref->bypassed = 0;
+    return 0;
+}
+
+/*****************************************************************************/
+
+/** Gets the state of a request handled via the request ring.
+ *
+ * New data of a successful read operation are copied once to \a mem.
+ *
+ * \return Request state.
+ */
+ec_request_state_t ec_request_ring_state(
+        const ec_master_t *master, /**< EtherCAT master. */
+        ec_request_ring_ref_t *ref, /**< Request ring reference. */
+        uint8_t *mem, /**< Data memory of the request. */
+        size_t mem_size, /**< Size of \a mem. */
+        size_t *data_size /**< Size of the copied data (output). */
+        )
+{
+    const volatile ec_ioctl_ring_entry_t *entry = ref->entry;
+    ec_request_state_t state;
+    size_t size;
+
+    if (entry->sequence != ref->sequence) {
+        return EC_REQUEST_BUSY; // not yet consumed by the master
+    }
+
+    __sync_synchronize(); // sequence before the state
+    state = entry->state;
+
+    if (state != EC_REQUEST_SUCCESS || ref->fetched) {
+        return state;
+    }
+
+    __sync_synchronize(); // state before the data
+    size = entry->data_size;
+    if (size) { // new data waiting to be copied
+        if (mem_size < size) {
+            EC_PRINT_ERR("Received %zu bytes do not fit into request data"
+                    " memory (%zu bytes)!\n", size, mem_size);
+            return EC_REQUEST_ERROR;
+        }
+        memcpy(mem, (const uint8_t *) master->ring + entry->data_offset,
+                size);
+        *data_size = size;
+    }
+
+    ref->fetched = 1;
+    return state;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,62 @@
+/******************************************************************************
+ *
+ *  $Id$
+ *
+ *  Copyright (C) 2006-2009  Florian Pose, Ingenieurgemeinschaft IgH
+ *
+ *  This file is part of the IgH EtherCAT master userspace library.
+ *
+ *  The IgH EtherCAT master userspace library is free software; you can
+ *  redistribute it and/or modify it under the terms of the GNU Lesser General
+ *  Public License as published by the Free Software Foundation; version 2.1
+ *  of the License.
+ *
+ *  The IgH EtherCAT master userspace library is distributed in the hope that
+ *  it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ *  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the IgH EtherCAT master userspace library. If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ *  ---
+ *
+ *  The license mentioned above concerns the source code only. Using the
+ *  EtherCAT technology and brand is only permitted in compliance with the
+ *  industrial property and similar rights of Beckhoff Automation GmbH.
+ *
+ *****************************************************************************/
+
+#ifndef __EC_LIB_REQUEST_RING_H__
+#define __EC_LIB_REQUEST_RING_H__
+
+#include "include/ecrt.h"
+#include "ioctl.h"
+
+/*****************************************************************************/
+
+/** Reference of a request to its request ring entry.
+ */
+typedef struct {
+    const ec_ioctl_ring_entry_t *entry; /**< Request entry, or NULL, if the
+                                          request is handled via ioctl(). */
+    uint32_t sequence; /**< Number of submissions. */
+    int fetched; /**< Data of the last completion have been fetched. */
+    int bypassed; /**< The last operation could not be submitted to the
+                    ring and was started via ioctl(). */
+} ec_request_ring_ref_t;
+
+/*****************************************************************************/
+
+void ec_request_ring_ref_init(ec_request_ring_ref_t *);
+
+void ec_request_ring_attach(ec_master_t *);
+int ec_request_ring_submit(ec_master_t *, ec_request_ring_ref_t *,
+        unsigned int, uint16_t, const uint8_t *, size_t);
+ec_request_state_t ec_request_ring_state(const ec_master_t *,
+        ec_request_ring_ref_t *, uint8_t *, size_t, size_t *);
+
+/*****************************************************************************/
+
+#endif
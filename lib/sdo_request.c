@@ -132,6 +132,11 @@ ec_request_state_t ecrt_sdo_request_state(ec_sdo_request_t *req)
     ec_ioctl_sdo_request_t data;
     int ret;
 
+    if (req->ring.entry && !req->ring.bypassed) {
+        return ec_request_ring_state(req->config->master, &req->ring,
+                req->data, req->mem_size, &req->data_size);
+    }
+
     data.config_index = req->config->index;
     data.request_index = req->index;
 
@@ -171,6 +176,11 @@ void ecrt_sdo_request_read(ec_sdo_request_t *req)
     ec_ioctl_sdo_request_t data;
     int ret;
 
+    if (req->ring.entry && !ec_request_ring_submit(req->config->master,
+                &req->ring, EC_IOCTL_RING_READ, 0, NULL, 0)) {
+        return; // otherwise started via ioctl()
+    }
+
     data.config_index = req->config->index;
     data.request_index = req->index;
 
@@ -188,6 +198,12 @@ void ecrt_sdo_request_write(ec_sdo_request_t *req)
     ec_ioctl_sdo_request_t data;
     int ret;
 
+    if (req->ring.entry && !ec_request_ring_submit(req->config->master,
+                &req->ring, EC_IOCTL_RING_WRITE, 0, req->data,
+                req->data_size)) {
+        return; // otherwise started via ioctl()
+    }
+
     data.config_index = req->config->index;
     data.request_index = req->index;
     data.data = req->data;
@@ -207,6 +223,11 @@ void ecrt_sdo_request_write_with_size(ec_sdo_request_t *req, size_t size)
     ec_ioctl_sdo_request_t data;
     int ret;
 
+    if (req->ring.entry && !ec_request_ring_submit(req->config->master,
+                &req->ring, EC_IOCTL_RING_WRITE, 0, req->data, size)) {
+        return; // otherwise started via ioctl()
+    }
+
     data.config_index = req->config->index;
     data.request_index = req->index;
     data.data = req->data;
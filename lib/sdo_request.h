@@ -29,6 +29,7 @@
  *****************************************************************************/
 
 #include "include/ecrt.h"
+#include "request_ring.h"
 
 /*****************************************************************************/
 
@@ -41,6 +42,7 @@ struct ec_sdo_request {
     uint8_t *data; /**< Pointer to SDO data. */
     size_t mem_size; /**< Size of SDO data memory. */
     size_t data_size; /**< Size of SDO data. */
+    ec_request_ring_ref_t ring; /**< Request ring reference. */
 };
 
 /*****************************************************************************/
@@ -377,6 +377,29 @@ int ecrt_slave_config_reg_pdo_entry_pos(
 
 /*****************************************************************************/
 
+int ecrt_slave_config_reg_esc_registers(ec_slave_config_t *sc,
+        uint16_t address, uint16_t size, ec_domain_t *domain)
+{
+    ec_ioctl_reg_esc_t io;
+    int ret;
+
+    io.config_index = sc->index;
+    io.address = address;
+    io.size = size;
+    io.domain_index = domain->index;
+
+    ret = ioctl(sc->master->fd, EC_IOCTL_SC_REG_ESC, &io);
+    if (EC_IOCTL_IS_ERROR(ret)) {
+        EC_PRINT_ERR("Failed to register ESC registers: %s\n",
+                strerror(EC_IOCTL_ERRNO(ret)));
+        return -EC_IOCTL_ERRNO(ret);
+    }
+
+    return ret;
+}
+
+/*****************************************************************************/
+
 void ecrt_slave_config_dc(ec_slave_config_t *sc, uint16_t assign_activate,
         uint32_t sync0_cycle_time, int32_t sync0_shift_time,
         uint32_t sync1_cycle_time, int32_t sync1_shift_time)
@@ -626,6 +649,7 @@ ec_sdo_request_t *ecrt_slave_config_create_sdo_request(ec_slave_config_t *sc,
     req->sdo_subindex = data.sdo_subindex;
     req->data_size = size;
     req->mem_size = size;
+    ec_request_ring_ref_init(&req->ring);
 
     ec_slave_config_add_sdo_request(sc, req);
 
@@ -681,6 +705,7 @@ ec_sdo_request_t *ecrt_slave_config_create_sdo_request_complete(ec_slave_config_
     req->sdo_subindex = data.sdo_subindex;
     req->data_size = size;
     req->mem_size = size;
+    ec_request_ring_ref_init(&req->ring);
 
     ec_slave_config_add_sdo_request(sc, req);
 
@@ -747,6 +772,8 @@ ec_foe_request_t *ecrt_slave_config_create_foe_request(ec_slave_config_t *sc,
     req->index = data.request_index;
     req->data_size = size;
     req->mem_size = size;
+    req->stream = 0;
+    ec_request_ring_ref_init(&req->ring);
 
     ec_slave_config_add_foe_request(sc, req);
 
@@ -812,6 +839,7 @@ ec_reg_request_t *ecrt_slave_config_create_reg_request(ec_slave_config_t *sc,
     reg->config = sc;
     reg->index = io.request_index;
     reg->mem_size = size;
+    ec_request_ring_ref_init(&reg->ring);
 
     ec_slave_config_add_reg_request(sc, reg);
 
@@ -889,9 +917,17 @@ ec_voe_handler_t *ecrt_slave_config_create_voe_handler(ec_slave_config_t *sc,
 void ecrt_slave_config_state(const ec_slave_config_t *sc,
         ec_slave_config_state_t *state)
 {
+    const ec_ioctl_status_t *status = sc->master->status;
     ec_ioctl_sc_state_t data;
     int ret;
 
+    if (status && sc->index < status->config_count
+            && !ec_master_read_status(sc->master, &status->sequence, state,
+                EC_IOCTL_STATUS_CONFIGS(status) + sc->index,
+                sizeof(*state))) {
+        return;
+    }
+
     data.config_index = sc->index;
     data.state = state;
 
@@ -37,6 +37,7 @@
 #include <linux/module.h>
 #include <linux/vmalloc.h>
 #include <linux/mm.h>
+#include <linux/poll.h>
 
 #include "cdev.h"
 #include "master.h"
@@ -55,6 +56,11 @@ static int eccdev_open(struct inode *, struct file *);
 static int eccdev_release(struct inode *, struct file *);
 static long eccdev_ioctl(struct file *, unsigned int, unsigned long);
 static int eccdev_mmap(struct file *, struct vm_area_struct *);
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 16, 0)
+static __poll_t eccdev_poll(struct file *, poll_table *);
+#else
+static unsigned int eccdev_poll(struct file *, poll_table *);
+#endif
 
 /** This is the kernel version from which the .fault member of the
  * vm_operations_struct is usable.
@@ -87,7 +93,8 @@ static struct file_operations eccdev_fops = {
     .open           = eccdev_open,
     .release        = eccdev_release,
     .unlocked_ioctl = eccdev_ioctl,
-    .mmap           = eccdev_mmap
+    .mmap           = eccdev_mmap,
+    .poll           = eccdev_poll
 };
 
 /** Callbacks for a virtual memory area retrieved with ecdevc_mmap().
@@ -169,6 +176,11 @@ int eccdev_open(struct inode *inode, struct file *filp)
     priv->ctx.requested = 0;
     priv->ctx.process_data = NULL;
     priv->ctx.process_data_size = 0;
+    priv->ctx.events = EC_EVENT_ALL;
+    ec_master_fetch_events(cdev->master, priv->ctx.event_acks, 0);
+    ec_master_init_event_binding(&priv->ctx.event_binding);
+    priv->ctx.foe_stream = NULL;
+    priv->ctx.foe_bulk = NULL;
 
     filp->private_data = priv;
 
@@ -187,6 +199,10 @@ int eccdev_release(struct inode *inode, struct file *filp)
     ec_cdev_priv_t *priv = (ec_cdev_priv_t *) filp->private_data;
     ec_master_t *master = priv->cdev->master;
 
+    ec_master_unbind_eventfd(master, &priv->ctx.event_binding);
+    ec_ioctl_foe_stream_abort(master, &priv->ctx);
+    ec_ioctl_foe_bulk_abort(master, &priv->ctx);
+
     if (priv->ctx.requested) {
         ecrt_release_master(master);
     }
@@ -222,6 +238,33 @@ long eccdev_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 
 /*****************************************************************************/
 
+/** Called when the cdev is polled.
+ *
+ * The file is readable, as long as master events selected via
+ * EC_IOCTL_EVENTS are pending for the file handle.
+ */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 16, 0)
+__poll_t
+#else
+unsigned int
+#endif
+eccdev_poll(struct file *filp, poll_table *wait)
+{
+    ec_cdev_priv_t *priv = (ec_cdev_priv_t *) filp->private_data;
+    ec_master_t *master = priv->cdev->master;
+
+    poll_wait(filp, &master->event_queue, wait);
+
+    if (ec_master_pending_events(master, priv->ctx.event_acks,
+                priv->ctx.events)) {
+        return POLLIN | POLLRDNORM;
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+
 #ifndef VM_DONTDUMP
 /** VM_RESERVED disappeared in 3.7.
  */
@@ -231,9 +274,12 @@ long eccdev_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
 /** Memory-map callback for the EtherCAT character device.
  *
  * The actual mapping will be done in the eccdev_vma_nopage() callback of the
- * virtual memory area.
+ * virtual memory area. The status page (at EC_IOCTL_STATUS_OFFSET) may only
+ * be mapped read-only. The request ring (at EC_IOCTL_RING_OFFSET) may only be
+ * mapped by the application that requested the master, via a file handle
+ * opened for writing.
  *
- * \return Always zero (success).
+ * \return Zero on success, otherwise a negative error code.
  */
 int eccdev_mmap(
         struct file *filp,
@@ -244,6 +290,19 @@ int eccdev_mmap(
 
     EC_MASTER_DBG(priv->cdev->master, 1, "mmap()\n");
 
+    if ((vma->vm_pgoff << PAGE_SHIFT) >= EC_IOCTL_STATUS_OFFSET
+            && (vma->vm_pgoff << PAGE_SHIFT) < EC_IOCTL_RING_OFFSET) {
+        if (vma->vm_flags & VM_WRITE) {
+            return -EACCES;
+        }
+        vma->vm_flags &= ~VM_MAYWRITE;
+    }
+
+    if ((vma->vm_pgoff << PAGE_SHIFT) >= EC_IOCTL_RING_OFFSET
+            && (!priv->ctx.requested || !priv->ctx.writable)) {
+        return -EACCES;
+    }
+
     vma->vm_ops = &eccdev_vm_ops;
     vma->vm_flags |= VM_DONTDUMP; /* Pages will not be swapped out */
     vma->vm_private_data = priv;
@@ -253,6 +312,51 @@ int eccdev_mmap(
 
 /*****************************************************************************/
 
+/** Gets the kernel address for an offset in the memory mapping.
+ *
+ * Offsets below EC_IOCTL_STATUS_OFFSET address the process data, offsets
+ * below EC_IOCTL_RING_OFFSET address the status page of the master, the
+ * others address the request ring (only for the file handle of the
+ * application that requested the master, see eccdev_mmap()).
+ *
+ * \return Kernel (vmalloc) address, or NULL if the offset is invalid.
+ */
+static void *eccdev_vma_address(
+        ec_cdev_priv_t *priv, /**< Private data structure of file handle. */
+        unsigned long offset /**< Offset in the memory mapping. */
+        )
+{
+    ec_master_t *master = priv->cdev->master;
+
+    if (offset < EC_IOCTL_STATUS_OFFSET) {
+        if (offset >= priv->ctx.process_data_size) {
+            return NULL;
+        }
+        return priv->ctx.process_data + offset;
+    }
+
+    if (offset < EC_IOCTL_RING_OFFSET) {
+        offset -= EC_IOCTL_STATUS_OFFSET;
+        if (!master->status || offset >= master->status_size) {
+            return NULL;
+        }
+        return (uint8_t *) master->status + offset;
+    }
+
+    if (!priv->ctx.requested || !priv->ctx.writable) {
+        return NULL;
+    }
+
+    offset -= EC_IOCTL_RING_OFFSET;
+    if (!master->request_ring.mem
+            || offset >= master->request_ring.mem_size) {
+        return NULL;
+    }
+    return (uint8_t *) master->request_ring.mem + offset;
+}
+
+/*****************************************************************************/
+
 #if LINUX_VERSION_CODE >= PAGE_FAULT_VERSION
 
 /** Page fault callback for a virtual memory area.
@@ -281,12 +385,13 @@ eccdev_vma_fault(
     unsigned long offset = vmf->pgoff << PAGE_SHIFT;
     ec_cdev_priv_t *priv = (ec_cdev_priv_t *) vma->vm_private_data;
     struct page *page;
+    void *address = eccdev_vma_address(priv, offset);
 
-    if (offset >= priv->ctx.process_data_size) {
+    if (!address) {
         return VM_FAULT_SIGBUS;
     }
 
-    page = vmalloc_to_page(priv->ctx.process_data + offset);
+    page = vmalloc_to_page(address);
     if (!page) {
         return VM_FAULT_SIGBUS;
     }
@@ -322,13 +427,15 @@ struct page *eccdev_vma_nopage(
     struct page *page = NOPAGE_SIGBUS;
     ec_cdev_priv_t *priv = (ec_cdev_priv_t *) vma->vm_private_data;
     ec_master_t *master = priv->cdev->master;
+    void *data;
 
     offset = (address - vma->vm_start) + (vma->vm_pgoff << PAGE_SHIFT);
 
-    if (offset >= priv->ctx.process_data_size)
+    data = eccdev_vma_address(priv, offset);
+    if (!data)
         return NOPAGE_SIGBUS;
 
-    page = vmalloc_to_page(priv->ctx.process_data + offset);
+    page = vmalloc_to_page(data);
 
     EC_MASTER_DBG(master, 1, "Nopage fault vma, address = %#lx,"
             " offset = %#lx, page = %p\n", address, offset, page);
@@ -37,6 +37,8 @@
 
 #include <linux/slab.h>
 
+#include "master.h"
+#include "slave_config.h"
 #include "coe_emerg_ring.h"
 
 /*****************************************************************************/
@@ -124,6 +126,8 @@ void ec_coe_emerg_ring_push(
     memcpy(ring->msgs[ring->write_index].data, msg,
             EC_COE_EMERGENCY_MSG_SIZE);
     ring->write_index = (ring->write_index + 1) % (ring->size + 1);
+
+    ec_master_post_event(ring->sc->master, EC_EVENT_EMERGENCY);
 }
 
 /*****************************************************************************/
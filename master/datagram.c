@@ -49,6 +49,7 @@
         return ret; \
     datagram->index = 0; \
     datagram->working_counter = 0; \
+    datagram->mbox_status = NULL; \
     datagram->state = EC_DATAGRAM_INIT;
 
 #define EC_FUNC_FOOTER \
@@ -88,14 +89,18 @@ static const char *type_strings[] = {
 void ec_datagram_init(ec_datagram_t *datagram /**< EtherCAT datagram. */)
 {
     INIT_LIST_HEAD(&datagram->queue); // mark as unqueued
+    INIT_LIST_HEAD(&datagram->sent);
     datagram->device_index = EC_DEVICE_MAIN;
     datagram->type = EC_DATAGRAM_NONE;
+    datagram->traffic_class = EC_DATAGRAM_CLASS_OTHER;
     memset(datagram->address, 0x00, EC_ADDR_LEN);
     datagram->data = NULL;
+    datagram->send_data = NULL;
     datagram->data_origin = EC_ORIG_INTERNAL;
     datagram->mem_size = 0;
     datagram->data_size = 0;
     datagram->index = 0x00;
+    datagram->index_entry = NULL;
     datagram->working_counter = 0x0000;
     datagram->state = EC_DATAGRAM_INIT;
 #ifdef EC_HAVE_CYCLES
@@ -108,6 +113,7 @@ void ec_datagram_init(ec_datagram_t *datagram /**< EtherCAT datagram. */)
 #endif
     datagram->jiffies_received = 0;
     datagram->skip_count = 0;
+    datagram->mbox_status = NULL;
     datagram->stats_output_jiffies = 0;
     memset(datagram->name, 0x00, EC_DATAGRAM_NAME_SIZE);
 }
@@ -135,6 +141,31 @@ void ec_datagram_unqueue(ec_datagram_t *datagram /**< EtherCAT datagram. */)
     if (!list_empty(&datagram->queue)) {
         list_del_init(&datagram->queue);
     }
+
+    ec_datagram_release(datagram);
+}
+
+/*****************************************************************************/
+
+/** Releases the master's references to a sent datagram.
+ *
+ * Removes the datagram's entry from the master's datagram index table and
+ * removes it from the master's sent queue. This has to be called whenever a
+ * sent datagram leaves the datagram queue, so that the index can be re-used
+ * and the master never refers to a datagram that is no longer pending.
+ */
+void ec_datagram_release(
+        ec_datagram_t *datagram /**< EtherCAT datagram. */
+        )
+{
+    if (datagram->index_entry) {
+        *datagram->index_entry = NULL;
+        datagram->index_entry = NULL;
+    }
+
+    if (!list_empty(&datagram->sent)) {
+        list_del_init(&datagram->sent);
+    }
 }
 
 /*****************************************************************************/
@@ -85,18 +85,25 @@ typedef enum {
 
 /** EtherCAT datagram.
  */
-typedef struct {
+typedef struct ec_datagram {
     struct list_head queue; /**< Master datagram queue item. */
-    struct list_head sent; /**< Master list item for sent datagrams. */
+    struct list_head sent; /**< Master sent queue item. */
     ec_device_index_t device_index; /**< Device via which the datagram shall
                                       be / was sent. */
     ec_datagram_type_t type; /**< Datagram type (APRD, BWR, etc.). */
+    ec_datagram_class_t traffic_class; /**< Class for latency statistics. */
     uint8_t address[EC_ADDR_LEN]; /**< Recipient address. */
     uint8_t *data; /**< Datagram payload. */
+    const uint8_t *send_data; /**< Payload to send instead of \a data, or
+                                \a NULL. Received data are always stored in
+                                \a data. */
     ec_origin_t data_origin; /**< Origin of the \a data memory. */
     size_t mem_size; /**< Datagram \a data memory size. */
     size_t data_size; /**< Size of the data in \a data. */
     uint8_t index; /**< Index (set by master). */
+    struct ec_datagram **index_entry; /**< Entry in the master's datagram
+                                        index table, or \a NULL, if no index
+                                        is allocated. */
     uint16_t working_counter; /**< Working counter. */
     ec_datagram_state_t state; /**< State. */
 #ifdef EC_HAVE_CYCLES
@@ -110,6 +117,9 @@ typedef struct {
     unsigned long jiffies_received; /**< Jiffies, when the datagram was
                                       received. */
     unsigned int skip_count; /**< Number of requeues when not yet received. */
+    const uint8_t *mbox_status; /**< Mailbox status of the recipient in the
+                                  master's mailbox status datagram, or \a
+                                  NULL. See ec_slave_mbox_prepare_check(). */
     unsigned long stats_output_jiffies; /**< Last statistics output. */
     char name[EC_DATAGRAM_NAME_SIZE]; /**< Description of the datagram. */
 } ec_datagram_t;
@@ -130,6 +140,7 @@ typedef struct {
 void ec_datagram_init(ec_datagram_t *);
 void ec_datagram_clear(ec_datagram_t *);
 void ec_datagram_unqueue(ec_datagram_t *);
+void ec_datagram_release(ec_datagram_t *);
 int ec_datagram_prealloc(ec_datagram_t *, size_t);
 void ec_datagram_zero(ec_datagram_t *);
 int ec_datagram_repeat(ec_datagram_t *, const ec_datagram_t *);
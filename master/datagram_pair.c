@@ -67,6 +67,7 @@ int ec_datagram_pair_init(
                 EC_DATAGRAM_NAME_SIZE, "domain%u-%u-%s", domain->index,
                 logical_offset, ec_device_names[dev_idx != 0]);
         pair->datagrams[dev_idx].device_index = dev_idx;
+        pair->datagrams[dev_idx].traffic_class = EC_DATAGRAM_CLASS_DOMAIN;
     }
 
     pair->expected_working_counter = 0U;
@@ -87,6 +88,14 @@ int ec_datagram_pair_init(
         ret = -ENOMEM;
         goto out_datagrams;
     }
+
+    /* Backup datagrams send the copy of the main data taken in
+     * ecrt_domain_queue() directly, their own memory only takes the
+     * received data. */
+    for (dev_idx = EC_DEVICE_BACKUP;
+            dev_idx < ec_master_num_devices(domain->master); dev_idx++) {
+        pair->datagrams[dev_idx].send_data = pair->send_buffer;
+    }
 #endif
 
     /* The ec_datagram_lxx() calls below can not fail, because either the
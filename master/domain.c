@@ -84,6 +84,7 @@ void ec_domain_init(
     domain->working_counter_changes = 0;
     domain->redundancy_active = 0;
     domain->notify_jiffies = 0;
+    domain->copied_bytes = 0;
 
     /* Used by ec_domain_add_fmmu_config */
     memset(domain->offset_used, 0, sizeof(domain->offset_used));
@@ -140,8 +141,12 @@ void ec_domain_add_fmmu_config(
     fmmu->domain = domain;
     sc = fmmu->sc;
 
-    fmmu_data_size = ec_pdo_list_total_size(
-        &sc->sync_configs[fmmu->sync_index].pdos);
+    if (fmmu->sync_index == EC_SYNC_REGISTERS) {
+        fmmu_data_size = fmmu->register_size;
+    } else {
+        fmmu_data_size = ec_pdo_list_total_size(
+            &sc->sync_configs[fmmu->sync_index].pdos);
+    }
 
     if (sc->allow_overlapping_pdos && (sc == domain->sc_in_work)) {
         // If we permit overlapped PDOs, and we already have an allocated FMMU
@@ -607,7 +612,8 @@ void ecrt_domain_process(ec_domain_t *domain)
 #if DEBUG_REDUNDANCY
                     EC_MASTER_DBG(domain->master, 1, "main changed\n");
 #endif
-                } else if (data_changed(pair->send_buffer, backup_datagram,
+                } else if (backup_datagram->state == EC_DATAGRAM_RECEIVED
+                        && data_changed(pair->send_buffer, backup_datagram,
                             datagram_offset, fmmu->data_size)) {
                     /* data changed on backup link: copy to main memory. */
 #if DEBUG_REDUNDANCY
@@ -616,6 +622,7 @@ void ecrt_domain_process(ec_domain_t *domain)
                     memcpy(main_datagram->data + datagram_offset,
                             backup_datagram->data + datagram_offset,
                             fmmu->data_size);
+                    domain->copied_bytes += fmmu->data_size;
                 } else if (datagram_pair_wc ==
                         pair->expected_working_counter) {
                     /* no change, but WC complete: use main data. */
@@ -715,6 +722,8 @@ void ecrt_domain_process(ec_domain_t *domain)
         domain->working_counter_changes = 0;
     }
 #endif
+
+    ec_master_status_update_domain(domain->master, domain);
 }
 
 /*****************************************************************************/
@@ -731,16 +740,16 @@ void ecrt_domain_queue(ec_domain_t *domain)
         memcpy(datagram_pair->send_buffer,
                 datagram_pair->datagrams[EC_DEVICE_MAIN].data,
                 datagram_pair->datagrams[EC_DEVICE_MAIN].data_size);
+        domain->copied_bytes +=
+            datagram_pair->datagrams[EC_DEVICE_MAIN].data_size;
 #endif
         ec_master_queue_datagram(domain->master,
                 &datagram_pair->datagrams[EC_DEVICE_MAIN]);
 
-        /* copy main data to backup datagram */
+        /* backup datagrams send the send buffer (see
+         * ec_datagram_pair_init()), so no further copy is necessary. */
         for (dev_idx = EC_DEVICE_BACKUP;
                 dev_idx < ec_master_num_devices(domain->master); dev_idx++) {
-            memcpy(datagram_pair->datagrams[dev_idx].data,
-                    datagram_pair->datagrams[EC_DEVICE_MAIN].data,
-                    datagram_pair->datagrams[EC_DEVICE_MAIN].data_size);
             ec_master_queue_datagram(domain->master,
                     &datagram_pair->datagrams[dev_idx]);
         }
@@ -72,6 +72,9 @@ struct ec_domain
                                              since last notification. */
     unsigned int redundancy_active; /**< Non-zero, if redundancy is in use. */
     unsigned long notify_jiffies; /**< Time of last notification. */
+    u64 copied_bytes; /**< Process data bytes copied between the datagrams
+                        of the domain by ecrt_domain_queue() and
+                        ecrt_domain_process(). */
     uint32_t offset_used[EC_DIR_COUNT]; /**< Next available domain offset of
         PDO, by direction */
     const ec_slave_config_t *sc_in_work; /**< slave_config which is actively
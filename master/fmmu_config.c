@@ -62,6 +62,36 @@ void ec_fmmu_config_init(
 
     fmmu->logical_domain_offset = 0;
     fmmu->data_size = 0;
+    fmmu->physical_address = 0x0000;
+    fmmu->register_size = 0;
+
+    ec_domain_add_fmmu_config(domain, fmmu);
+}
+
+/*****************************************************************************/
+
+/** FMMU configuration constructor for ESC registers.
+ *
+ * Inits an FMMU configuration, that maps a range of ESC registers for
+ * reading, and adds the register size to the domain data size.
+ */
+void ec_fmmu_config_init_registers(
+        ec_fmmu_config_t *fmmu, /**< EtherCAT FMMU configuration. */
+        ec_slave_config_t *sc, /**< EtherCAT slave configuration. */
+        ec_domain_t *domain, /**< EtherCAT domain. */
+        uint16_t address, /**< Physical start address. */
+        uint16_t size /**< Size of the register range. */
+        )
+{
+    INIT_LIST_HEAD(&fmmu->list);
+    fmmu->sc = sc;
+    fmmu->sync_index = EC_SYNC_REGISTERS;
+    fmmu->dir = EC_DIR_INPUT;
+
+    fmmu->logical_domain_offset = 0;
+    fmmu->data_size = 0;
+    fmmu->physical_address = address;
+    fmmu->register_size = size;
 
     ec_domain_add_fmmu_config(domain, fmmu);
 }
@@ -82,6 +112,7 @@ void ec_fmmu_set_domain_offset_size(
 /** Initializes an FMMU configuration page.
  *
  * The referenced memory (\a data) must be at least EC_FMMU_PAGE_SIZE bytes.
+ * For FMMUs mapping ESC registers, \a sync may be NULL.
  */
 void ec_fmmu_config_page(
         const ec_fmmu_config_t *fmmu, /**< EtherCAT FMMU configuration. */
@@ -89,10 +120,13 @@ void ec_fmmu_config_page(
         uint8_t *data /**> Configuration page memory. */
         )
 {
+    uint16_t physical_address = fmmu->sync_index == EC_SYNC_REGISTERS ?
+        fmmu->physical_address : sync->physical_start_address;
+
     EC_CONFIG_DBG(fmmu->sc, 1, "FMMU: LogOff 0x%08X, Size %3u,"
             " PhysAddr 0x%04X, SM%u, Dir %s\n",
             fmmu->logical_domain_offset, fmmu->data_size,
-            sync->physical_start_address, fmmu->sync_index,
+            physical_address, fmmu->sync_index,
             fmmu->dir == EC_DIR_INPUT ? "in" : "out");
 
     EC_WRITE_U32(data,      fmmu->domain->logical_base_address +
@@ -100,7 +134,7 @@ void ec_fmmu_config_page(
     EC_WRITE_U16(data + 4,  fmmu->data_size); // size of fmmu
     EC_WRITE_U8 (data + 6,  0x00); // logical start bit
     EC_WRITE_U8 (data + 7,  0x07); // logical end bit
-    EC_WRITE_U16(data + 8,  sync->physical_start_address);
+    EC_WRITE_U16(data + 8,  physical_address);
     EC_WRITE_U8 (data + 10, 0x00); // physical start bit
     EC_WRITE_U8 (data + 11, fmmu->dir == EC_DIR_INPUT ? 0x01 : 0x02);
     EC_WRITE_U16(data + 12, 0x0001); // enable
@@ -52,12 +52,18 @@ typedef struct {
     uint32_t logical_domain_offset; /**< Logical offset address relative to
                 domain->logical_base_address. */
     unsigned int data_size; /**< Covered PDO size. */
+    uint16_t physical_address; /**< Physical start address of the mapped
+                                 ESC registers (only for \a
+                                 EC_SYNC_REGISTERS). */
+    uint16_t register_size; /**< Size of the mapped ESC registers. */
 } ec_fmmu_config_t;
 
 /*****************************************************************************/
 
 void ec_fmmu_config_init(ec_fmmu_config_t *, ec_slave_config_t *,
         ec_domain_t *, uint8_t, ec_direction_t);
+void ec_fmmu_config_init_registers(ec_fmmu_config_t *, ec_slave_config_t *,
+        ec_domain_t *, uint16_t, uint16_t);
 
 /**
  * @param fmmu EtherCAT FMMU configuration.
@@ -64,6 +64,12 @@ void ec_foe_request_init(
     req->buffer_size = 0;
     req->data_size = 0;
     req->progress = 0;
+    req->borrowed = 0;
+    req->stream = 0;
+    req->stream_in = 0;
+    req->stream_out = 0;
+    req->stream_end = 0;
+    req->stream_abort = 0;
     req->dir = EC_DIR_INVALID;
     req->issue_timeout = 0; // no timeout
     req->response_timeout = EC_FOE_REQUEST_RESPONSE_TIMEOUT;
@@ -92,10 +98,13 @@ void ec_foe_request_clear_data(
         )
 {
     if (req->buffer) {
-        kfree(req->buffer);
+        if (!req->borrowed) {
+            kfree(req->buffer);
+        }
         req->buffer = NULL;
     }
 
+    req->borrowed = 0;
     req->buffer_size = 0;
     req->data_size = 0;
 }
@@ -114,7 +123,7 @@ int ec_foe_request_alloc(
         size_t size /**< Data size to allocate. */
         )
 {
-    if (size <= req->buffer_size) {
+    if (size <= req->buffer_size && !req->borrowed) {
         return 0;
     }
 
@@ -132,6 +141,27 @@ int ec_foe_request_alloc(
 
 /*****************************************************************************/
 
+/** Uses external memory as data memory.
+ *
+ * This allows several write requests to share one copy of a file. The memory
+ * is not freed by the request and must not be changed while the request is
+ * processed.
+ */
+void ec_foe_request_borrow(
+        ec_foe_request_t *req, /**< FoE request. */
+        uint8_t *buffer, /**< External memory. */
+        size_t size /**< Size of \a buffer. */
+        )
+{
+    ec_foe_request_clear_data(req);
+
+    req->buffer = buffer;
+    req->buffer_size = size;
+    req->borrowed = 1;
+}
+
+/*****************************************************************************/
+
 /** Copies FoE data from an external source.
  *
  * If the \a buffer_size is to small, new memory is allocated.
@@ -170,6 +200,220 @@ int ec_foe_request_timed_out(
         && jiffies - req->jiffies_start > HZ * req->issue_timeout / 1000;
 }
 
+/*****************************************************************************/
+
+/** Prepares a streamed transfer.
+ *
+ * The request's \a buffer is used as a ring buffer, that is filled by the
+ * producer (the application when writing, the FoE state machine when
+ * reading) and drained by the consumer while the transfer is running. There
+ * is exactly one producer and one consumer, so no locking is needed.
+ */
+void ec_foe_request_stream_start(
+        ec_foe_request_t *req, /**< FoE request. */
+        ec_direction_t dir /**< Transfer direction. */
+        )
+{
+    req->stream = 1;
+    req->stream_in = 0;
+    req->stream_out = 0;
+    req->stream_end = 0;
+    req->stream_abort = 0;
+    req->data_size = 0;
+    req->progress = 0;
+    req->dir = dir;
+    req->state = EC_INT_REQUEST_QUEUED;
+    req->result = FOE_BUSY;
+    req->jiffies_start = jiffies;
+}
+
+/*****************************************************************************/
+
+/** Returns the number of bytes in the stream buffer.
+ *
+ * \return Number of bytes, that can be taken from the stream buffer.
+ */
+size_t ec_foe_request_stream_fill(
+        const ec_foe_request_t *req /**< FoE request. */
+        )
+{
+    return req->stream_in - req->stream_out;
+}
+
+/*****************************************************************************/
+
+/** Returns the free space in the stream buffer.
+ *
+ * \return Number of bytes, that can be written to the stream buffer.
+ */
+size_t ec_foe_request_stream_space(
+        const ec_foe_request_t *req /**< FoE request. */
+        )
+{
+    return req->buffer_size - ec_foe_request_stream_fill(req);
+}
+
+/*****************************************************************************/
+
+/** Returns the contiguous free memory at the write position of the stream
+ * buffer.
+ *
+ * The memory has to be handed over with ec_foe_request_stream_commit() after
+ * writing.
+ *
+ * \return Write position.
+ */
+uint8_t *ec_foe_request_stream_write_ptr(
+        ec_foe_request_t *req, /**< FoE request. */
+        size_t *size /**< Return value: Size of the free memory. */
+        )
+{
+    size_t offset;
+
+    if (!req->buffer_size) {
+        *size = 0;
+        return req->buffer;
+    }
+
+    offset = req->stream_in % req->buffer_size;
+    *size = min(ec_foe_request_stream_space(req),
+            req->buffer_size - offset);
+    smp_mb(); // do not overwrite data, before they are released
+    return req->buffer + offset;
+}
+
+/*****************************************************************************/
+
+/** Hands data written to the stream buffer over to the consumer.
+ */
+void ec_foe_request_stream_commit(
+        ec_foe_request_t *req, /**< FoE request. */
+        size_t size /**< Number of bytes written. */
+        )
+{
+    smp_wmb(); // publish the data before the new fill level
+    req->stream_in += size;
+}
+
+/*****************************************************************************/
+
+/** Returns the contiguous data at the read position of the stream buffer.
+ *
+ * The data have to be handed back with ec_foe_request_stream_release()
+ * after reading.
+ *
+ * \return Read position.
+ */
+const uint8_t *ec_foe_request_stream_read_ptr(
+        const ec_foe_request_t *req, /**< FoE request. */
+        size_t *size /**< Return value: Number of contiguous bytes. */
+        )
+{
+    size_t offset;
+
+    if (!req->buffer_size) {
+        *size = 0;
+        return req->buffer;
+    }
+
+    offset = req->stream_out % req->buffer_size;
+    *size = min(ec_foe_request_stream_fill(req), req->buffer_size - offset);
+    smp_rmb(); // read the fill level before the data
+    return req->buffer + offset;
+}
+
+/*****************************************************************************/
+
+/** Hands memory read from the stream buffer back to the producer.
+ */
+void ec_foe_request_stream_release(
+        ec_foe_request_t *req, /**< FoE request. */
+        size_t size /**< Number of bytes read. */
+        )
+{
+    smp_mb(); // finish reading, before the memory can be overwritten
+    req->stream_out += size;
+}
+
+/*****************************************************************************/
+
+/** Writes data to the stream buffer.
+ *
+ * \return Number of bytes written.
+ */
+size_t ec_foe_request_stream_put(
+        ec_foe_request_t *req, /**< FoE request. */
+        const uint8_t *data, /**< Data to write. */
+        size_t size /**< Number of bytes in \a data. */
+        )
+{
+    size_t count = 0, chunk;
+    uint8_t *ptr;
+
+    while (count < size) {
+        ptr = ec_foe_request_stream_write_ptr(req, &chunk);
+        if (!chunk) {
+            break;
+        }
+        chunk = min(chunk, size - count);
+        memcpy(ptr, data + count, chunk);
+        ec_foe_request_stream_commit(req, chunk);
+        count += chunk;
+    }
+
+    return count;
+}
+
+/*****************************************************************************/
+
+/** Takes data from the stream buffer.
+ *
+ * \return Number of bytes read.
+ */
+size_t ec_foe_request_stream_get(
+        ec_foe_request_t *req, /**< FoE request. */
+        uint8_t *data, /**< Target memory. */
+        size_t size /**< Size of \a data. */
+        )
+{
+    size_t count = 0, chunk;
+    const uint8_t *ptr;
+
+    while (count < size) {
+        ptr = ec_foe_request_stream_read_ptr(req, &chunk);
+        if (!chunk) {
+            break;
+        }
+        chunk = min(chunk, size - count);
+        memcpy(data + count, ptr, chunk);
+        ec_foe_request_stream_release(req, chunk);
+        count += chunk;
+    }
+
+    return count;
+}
+
+/*****************************************************************************/
+
+/** Copies data from the stream buffer without taking them.
+ *
+ * The caller has to make sure, that at least \a size bytes are available.
+ */
+void ec_foe_request_stream_peek(
+        const ec_foe_request_t *req, /**< FoE request. */
+        uint8_t *data, /**< Target memory. */
+        size_t size /**< Number of bytes to copy. */
+        )
+{
+    size_t chunk;
+    const uint8_t *ptr;
+
+    ptr = ec_foe_request_stream_read_ptr(req, &chunk);
+    chunk = min(chunk, size);
+    memcpy(data, ptr, chunk);
+    memcpy(data + chunk, req->buffer, size - chunk); // wrapped part
+}
+
 /*****************************************************************************
  * Application interface.
  ****************************************************************************/
@@ -268,6 +512,7 @@ void ecrt_foe_request_read(
 {
     req->data_size = 0;
     req->progress = 0;
+    req->stream = 0;
     req->dir = EC_DIR_INPUT;
     req->state = EC_INT_REQUEST_QUEUED;
     req->result = FOE_BUSY;
@@ -291,6 +536,7 @@ void ecrt_foe_request_write(
     }
     req->data_size = data_size;
     req->progress = 0;
+    req->stream = 0;
     req->dir = EC_DIR_OUTPUT;
     req->state = EC_INT_REQUEST_QUEUED;
     req->result = FOE_BUSY;
@@ -299,6 +545,74 @@ void ecrt_foe_request_write(
 
 /*****************************************************************************/
 
+/** Prepares a streamed write request (master to slave).
+ */
+void ecrt_foe_request_stream_write(
+        ec_foe_request_t *req /**< FoE request. */
+        )
+{
+    ec_foe_request_stream_start(req, EC_DIR_OUTPUT);
+}
+
+/*****************************************************************************/
+
+/** Prepares a streamed read request (slave to master).
+ */
+void ecrt_foe_request_stream_read(
+        ec_foe_request_t *req /**< FoE request. */
+        )
+{
+    ec_foe_request_stream_start(req, EC_DIR_INPUT);
+}
+
+/*****************************************************************************/
+
+/** Passes file data to a streamed write request.
+ *
+ * \return Number of bytes accepted.
+ */
+size_t ecrt_foe_request_stream_push(
+        ec_foe_request_t *req, /**< FoE request. */
+        const uint8_t *data, /**< File data. */
+        size_t size, /**< Number of bytes in \a data. */
+        int last /**< \a data end the file. */
+        )
+{
+    size_t count;
+
+    if (!req->stream || req->dir != EC_DIR_OUTPUT || req->stream_end) {
+        return 0;
+    }
+
+    count = ec_foe_request_stream_put(req, data, size);
+    if (last && count == size) {
+        smp_wmb(); // publish the fill level before the end mark
+        req->stream_end = 1;
+    }
+    return count;
+}
+
+/*****************************************************************************/
+
+/** Takes file data from a streamed read request.
+ *
+ * \return Number of bytes copied.
+ */
+size_t ecrt_foe_request_stream_pull(
+        ec_foe_request_t *req, /**< FoE request. */
+        uint8_t *data, /**< Target memory. */
+        size_t size /**< Size of \a data. */
+        )
+{
+    if (!req->stream || req->dir != EC_DIR_INPUT) {
+        return 0;
+    }
+
+    return ec_foe_request_stream_get(req, data, size);
+}
+
+/*****************************************************************************/
+
 /** \cond */
 
 EXPORT_SYMBOL(ecrt_foe_request_file);
@@ -311,6 +625,10 @@ EXPORT_SYMBOL(ecrt_foe_request_error_code);
 EXPORT_SYMBOL(ecrt_foe_request_progress);
 EXPORT_SYMBOL(ecrt_foe_request_read);
 EXPORT_SYMBOL(ecrt_foe_request_write);
+EXPORT_SYMBOL(ecrt_foe_request_stream_write);
+EXPORT_SYMBOL(ecrt_foe_request_stream_read);
+EXPORT_SYMBOL(ecrt_foe_request_stream_push);
+EXPORT_SYMBOL(ecrt_foe_request_stream_pull);
 
 /** \endcond */
 
@@ -45,6 +45,16 @@
 
 /*****************************************************************************/
 
+/** Size of the kernel buffer used for streamed FoE transfers of the command
+ * line tool.
+ *
+ * The buffer holds two chunks, so that one chunk can be copied from or to
+ * user space while the other one is transferred.
+ */
+#define EC_FOE_STREAM_BUFFER_SIZE (2 * 16384)
+
+/*****************************************************************************/
+
 /** FoE request.
  */
 struct ec_foe_request {
@@ -53,6 +63,16 @@ struct ec_foe_request {
     size_t buffer_size; /**< Size of FoE data memory. */
     size_t data_size; /**< Size of FoE data. */
     size_t progress; /**< Current position of a BUSY request. */
+    unsigned int borrowed; /**< \a buffer is owned by somebody else and is
+                             not freed by the request. */
+
+    unsigned int stream; /**< The file data are passed through \a buffer
+                           in chunks while the transfer is running. */
+    size_t stream_in; /**< Number of bytes written to the stream buffer. */
+    size_t stream_out; /**< Number of bytes taken from the stream buffer. */
+    unsigned int stream_end; /**< No more data will be written to the stream
+                               buffer. */
+    unsigned int stream_abort; /**< The stream was abandoned by its user. */
 
     uint32_t issue_timeout; /**< Maximum time in ms, the processing of the
                               request may take. */
@@ -77,9 +97,24 @@ void ec_foe_request_init(ec_foe_request_t *);
 void ec_foe_request_clear(ec_foe_request_t *);
 
 int ec_foe_request_alloc(ec_foe_request_t *, size_t);
+void ec_foe_request_borrow(ec_foe_request_t *, uint8_t *, size_t);
 int ec_foe_request_copy_data(ec_foe_request_t *, const uint8_t *, size_t);
 int ec_foe_request_timed_out(const ec_foe_request_t *);
 
+void ec_foe_request_stream_start(ec_foe_request_t *, ec_direction_t);
+size_t ec_foe_request_stream_fill(const ec_foe_request_t *);
+size_t ec_foe_request_stream_space(const ec_foe_request_t *);
+uint8_t *ec_foe_request_stream_write_ptr(ec_foe_request_t *, size_t *);
+void ec_foe_request_stream_commit(ec_foe_request_t *, size_t);
+const uint8_t *ec_foe_request_stream_read_ptr(const ec_foe_request_t *,
+        size_t *);
+void ec_foe_request_stream_release(ec_foe_request_t *, size_t);
+size_t ec_foe_request_stream_put(ec_foe_request_t *, const uint8_t *,
+        size_t);
+size_t ec_foe_request_stream_get(ec_foe_request_t *, uint8_t *, size_t);
+void ec_foe_request_stream_peek(const ec_foe_request_t *, uint8_t *,
+        size_t);
+
 /*****************************************************************************/
 
 #endif
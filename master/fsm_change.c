@@ -196,6 +196,25 @@ static void ec_fsm_change_prepare_read_code(
     ec_datagram_zero(datagram);
 }
 
+/*****************************************************************************/
+
+/** Takes over the AL state read by the last datagram.
+ *
+ * Posts EC_EVENT_AL_STATE to the master, if the state changed.
+ */
+static void ec_fsm_change_update_state(
+        ec_fsm_change_t *fsm /**< finite state machine */
+        )
+{
+    ec_slave_t *slave = fsm->slave;
+    uint8_t state = EC_READ_U8(fsm->datagram->data);
+
+    if (state != slave->current_state) {
+        slave->current_state = state;
+        ec_master_post_event(slave->master, EC_EVENT_AL_STATE);
+    }
+}
+
 /******************************************************************************
  *  state change state machine
  *****************************************************************************/
@@ -321,7 +340,7 @@ void ec_fsm_change_state_status(
         fsm->jiffies_start = fsm->datagram->jiffies_sent;
     }
 
-    slave->current_state = EC_READ_U8(fsm->datagram->data);
+    ec_fsm_change_update_state(fsm);
 
     if (slave->current_state == fsm->requested_state) {
         // state has been set successfully
@@ -583,7 +602,7 @@ void ec_fsm_change_state_check_ack(
         fsm->jiffies_start = fsm->datagram->jiffies_sent;
     }
 
-    slave->current_state = EC_READ_U8(fsm->datagram->data);
+    ec_fsm_change_update_state(fsm);
 
     if (!(slave->current_state & EC_SLAVE_STATE_ACK_ERR)) {
         char state_str[EC_STATE_STRING_SIZE];
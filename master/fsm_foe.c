@@ -95,6 +95,8 @@ void ec_fsm_foe_state_data_read(ec_fsm_foe_t *, ec_datagram_t *);
 void ec_fsm_foe_state_data_read_data(ec_fsm_foe_t *, ec_datagram_t *);
 void ec_fsm_foe_state_sent_ack(ec_fsm_foe_t *, ec_datagram_t *);
 
+void ec_fsm_foe_state_stream_wait(ec_fsm_foe_t *, ec_datagram_t *);
+
 void ec_fsm_foe_write_start(ec_fsm_foe_t *, ec_datagram_t *);
 void ec_fsm_foe_read_start(ec_fsm_foe_t *, ec_datagram_t *);
 
@@ -208,20 +210,36 @@ void ec_fsm_foe_end(
 
 /** Sends a file or the next fragment.
  *
- * \return Zero on success, otherwise a negative error code.
+ * For a streamed request, the fragment is only sent, if either a complete
+ * fragment is available in the stream buffer, or the stream was ended.
+ *
+ * \return Zero on success, a positive value, if the stream buffer does not
+ *         contain enough data yet, otherwise a negative error code.
  */
 int ec_foe_prepare_data_send(
         ec_fsm_foe_t *fsm, /**< Finite state machine. */
         ec_datagram_t *datagram /**< Datagram to use. */
         )
 {
+    ec_foe_request_t *request = fsm->request;
     size_t remaining_size, current_size;
+    unsigned int stream_end;
     uint8_t *data;
 
-    remaining_size = fsm->buffer_size - fsm->buffer_offset;
     current_size = fsm->slave->configured_tx_mailbox_size
             - EC_MBOX_HEADER_SIZE - EC_FOE_HEADER_SIZE;
 
+    if (request->stream) {
+        stream_end = request->stream_end;
+        smp_rmb(); // read the end mark before the fill level
+        remaining_size = ec_foe_request_stream_fill(request);
+        if (remaining_size < current_size && !stream_end) {
+            return 1;
+        }
+    } else {
+        remaining_size = fsm->buffer_size - fsm->buffer_offset;
+    }
+
     if (remaining_size < current_size) {
         current_size = remaining_size;
         fsm->last_packet = 1;
@@ -240,8 +258,14 @@ int ec_foe_prepare_data_send(
             EC_FOE_OPCODE_DATA, fsm->packet_no);
 #endif
 
-    memcpy(data + EC_FOE_HEADER_SIZE,
-            fsm->request->buffer + fsm->buffer_offset, current_size);
+    if (request->stream) {
+        // the data are released, when the fragment is acknowledged
+        ec_foe_request_stream_peek(request, data + EC_FOE_HEADER_SIZE,
+                current_size);
+    } else {
+        memcpy(data + EC_FOE_HEADER_SIZE,
+                request->buffer + fsm->buffer_offset, current_size);
+    }
     fsm->current_size = current_size;
 
     return 0;
@@ -314,6 +338,15 @@ void ec_fsm_foe_write_start(
         return;
     }
 
+    if (fsm->request->stream && fsm->request->buffer_size <
+            slave->configured_tx_mailbox_size
+            - EC_MBOX_HEADER_SIZE - EC_FOE_HEADER_SIZE) {
+        ec_foe_set_tx_error(fsm, FOE_PROT_ERROR);
+        EC_SLAVE_ERR(slave, "FoE stream buffer of %zu bytes is smaller"
+                " than a mailbox fragment.\n", fsm->request->buffer_size);
+        return;
+    }
+
     if (ec_foe_prepare_wrq_send(fsm, datagram)) {
         ec_foe_set_tx_error(fsm, FOE_PROT_ERROR);
         return;
@@ -436,6 +469,7 @@ void ec_fsm_foe_state_ack_read_data(
     uint8_t *data, mbox_prot;
     uint8_t opCode;
     size_t rec_size;
+    int ret;
 
     // process the data available or initiate a new mailbox read check
     if (slave->mbox_foe_data.payload_size > 0) {
@@ -472,11 +506,18 @@ void ec_fsm_foe_state_ack_read_data(
 
     if (opCode == EC_FOE_OPCODE_BUSY) {
         // slave not ready
-        if (ec_foe_prepare_data_send(fsm, datagram)) {
+        ret = ec_foe_prepare_data_send(fsm, datagram);
+        if (ret < 0) {
             ec_foe_set_tx_error(fsm, FOE_PROT_ERROR);
             EC_SLAVE_ERR(slave, "Slave is busy.\n");
             return;
         }
+        if (ret > 0) {
+            fsm->jiffies_start = jiffies;
+            fsm->state = ec_fsm_foe_state_stream_wait;
+            datagram->state = EC_DATAGRAM_INVALID;
+            return;
+        }
         fsm->state = ec_fsm_foe_state_data_sent;
         return;
     }
@@ -500,15 +541,32 @@ void ec_fsm_foe_state_ack_read_data(
         fsm->buffer_offset += fsm->current_size;
         fsm->request->progress = fsm->buffer_offset;
 
+        if (fsm->request->stream) {
+            ec_foe_request_stream_release(fsm->request, fsm->current_size);
+            fsm->current_size = 0;
+            wake_up_all(&slave->master->request_queue);
+        }
+
         if (fsm->last_packet) {
+            if (fsm->request->stream) {
+                fsm->request->data_size = fsm->buffer_offset;
+            }
             fsm->state = ec_fsm_foe_end;
             return;
         }
 
-        if (ec_foe_prepare_data_send(fsm, datagram)) {
+        ret = ec_foe_prepare_data_send(fsm, datagram);
+        if (ret < 0) {
             ec_foe_set_tx_error(fsm, FOE_PROT_ERROR);
             return;
         }
+        if (ret > 0) {
+            // wait for the application to fill the stream buffer
+            fsm->jiffies_start = jiffies;
+            fsm->state = ec_fsm_foe_state_stream_wait;
+            datagram->state = EC_DATAGRAM_INVALID;
+            return;
+        }
         fsm->state = ec_fsm_foe_state_data_sent;
         return;
     }
@@ -755,6 +813,15 @@ void ec_fsm_foe_read_start(
         return;
     }
 
+    if (fsm->request->stream && fsm->request->buffer_size <
+            slave->configured_rx_mailbox_size
+            - EC_MBOX_HEADER_SIZE - EC_FOE_HEADER_SIZE) {
+        ec_foe_set_rx_error(fsm, FOE_PROT_ERROR);
+        EC_SLAVE_ERR(slave, "FoE stream buffer of %zu bytes is smaller"
+                " than a mailbox fragment.\n", fsm->request->buffer_size);
+        return;
+    }
+
     if (ec_foe_prepare_rrq_send(fsm, datagram)) {
         ec_foe_set_rx_error(fsm, FOE_PROT_ERROR);
         return;
@@ -953,6 +1020,39 @@ void ec_fsm_foe_state_data_read_data(
 
     rec_size -= EC_FOE_HEADER_SIZE;
 
+    if (fsm->request->stream) {
+        if (ec_foe_request_stream_put(fsm->request,
+                    data + EC_FOE_HEADER_SIZE, rec_size) != rec_size) {
+            EC_SLAVE_ERR(slave, "Data do not fit in stream buffer!\n");
+            ec_foe_set_rx_error(fsm, FOE_READ_OVER_ERROR);
+            return;
+        }
+        fsm->buffer_offset += rec_size;
+        fsm->request->progress = fsm->buffer_offset;
+        wake_up_all(&slave->master->request_queue);
+
+        fsm->last_packet =
+            (rec_size + EC_MBOX_HEADER_SIZE + EC_FOE_HEADER_SIZE
+             != slave->configured_rx_mailbox_size);
+
+        if (!fsm->last_packet && ec_foe_request_stream_space(fsm->request)
+                < slave->configured_rx_mailbox_size
+                - EC_MBOX_HEADER_SIZE - EC_FOE_HEADER_SIZE) {
+            // wait for the application to drain the stream buffer
+            fsm->jiffies_start = jiffies;
+            fsm->state = ec_fsm_foe_state_stream_wait;
+            datagram->state = EC_DATAGRAM_INVALID;
+            return;
+        }
+
+        if (ec_foe_prepare_send_ack(fsm, datagram)) {
+            ec_foe_set_rx_error(fsm, FOE_RX_DATA_ACK_ERROR);
+            return;
+        }
+        fsm->state = ec_fsm_foe_state_sent_ack;
+        return;
+    }
+
     if (fsm->buffer_size >= fsm->buffer_offset + rec_size) {
         memcpy(fsm->request->buffer + fsm->buffer_offset,
                 data + EC_FOE_HEADER_SIZE, rec_size);
@@ -1029,6 +1129,10 @@ void ec_fsm_foe_state_sent_ack(
     if (fsm->last_packet) {
         fsm->packet_no = 0;
         fsm->request->data_size = fsm->buffer_offset;
+        if (fsm->request->stream) {
+            smp_wmb(); // publish the fill level before the end mark
+            fsm->request->stream_end = 1;
+        }
         fsm->state = ec_fsm_foe_end;
     }
     else {
@@ -1049,6 +1153,71 @@ void ec_fsm_foe_state_sent_ack(
 
 /*****************************************************************************/
 
+/** State: STREAM WAIT.
+ *
+ * Waits for the application to fill (write) or to drain (read) the stream
+ * buffer of a streamed request. The datagram is not used in the meantime.
+ */
+void ec_fsm_foe_state_stream_wait(
+        ec_fsm_foe_t *fsm, /**< FoE statemachine. */
+        ec_datagram_t *datagram /**< Datagram to use. */
+        )
+{
+    ec_slave_t *slave = fsm->slave;
+    ec_foe_request_t *request = fsm->request;
+    int ret;
+
+#ifdef DEBUG_FOE
+    EC_SLAVE_DBG(fsm->slave, 0, "%s()\n", __func__);
+#endif
+
+    if (request->stream_abort) {
+        EC_SLAVE_ERR(slave, "FoE stream was aborted.\n");
+        if (request->dir == EC_DIR_OUTPUT) {
+            ec_foe_set_tx_error(fsm, FOE_NODATA_ERROR);
+        } else {
+            ec_foe_set_rx_error(fsm, FOE_NODATA_ERROR);
+        }
+        return;
+    }
+
+    if (request->dir == EC_DIR_OUTPUT) {
+        ret = ec_foe_prepare_data_send(fsm, datagram);
+        if (ret < 0) {
+            ec_foe_set_tx_error(fsm, FOE_PROT_ERROR);
+            return;
+        }
+        if (!ret) {
+            fsm->state = ec_fsm_foe_state_data_sent;
+            return;
+        }
+    } else if (ec_foe_request_stream_space(request) >=
+            slave->configured_rx_mailbox_size
+            - EC_MBOX_HEADER_SIZE - EC_FOE_HEADER_SIZE) {
+        if (ec_foe_prepare_send_ack(fsm, datagram)) {
+            ec_foe_set_rx_error(fsm, FOE_RX_DATA_ACK_ERROR);
+            return;
+        }
+        fsm->state = ec_fsm_foe_state_sent_ack;
+        return;
+    }
+
+    if (time_after(jiffies, fsm->jiffies_start + EC_FSM_FOE_TIMEOUT_JIFFIES)) {
+        if (request->dir == EC_DIR_OUTPUT) {
+            ec_foe_set_tx_error(fsm, FOE_TIMEOUT_ERROR);
+        } else {
+            ec_foe_set_rx_error(fsm, FOE_TIMEOUT_ERROR);
+        }
+        EC_SLAVE_ERR(slave, "Timeout while waiting for stream data.\n");
+        return;
+    }
+
+    // the datagram is not used and marked as invalid
+    datagram->state = EC_DATAGRAM_INVALID;
+}
+
+/*****************************************************************************/
+
 /** Set an error code and go to the send error state.
  */
 void ec_foe_set_tx_error(
@@ -50,6 +50,15 @@
  */
 #define EC_SYSTEM_TIME_TOLERANCE_NS 1000
 
+/** Number of spare slaves to allocate on a full bus scan, so that slaves
+ * appended to the bus later can be scanned incrementally.
+ */
+#define EC_SPARE_SLAVES 8
+
+/** Timeout while waiting for the grouped AL state change [s].
+ */
+#define EC_GROUP_OP_TIMEOUT 5
+
 /*****************************************************************************/
 
 void ec_fsm_master_state_start(ec_fsm_master_t *);
@@ -59,6 +68,7 @@ void ec_fsm_master_state_read_al_status(ec_fsm_master_t *);
 void ec_fsm_master_state_read_dl_status(ec_fsm_master_t *);
 void ec_fsm_master_state_open_port(ec_fsm_master_t *);
 #endif
+void ec_fsm_master_state_verify_address(ec_fsm_master_t *);
 void ec_fsm_master_state_dc_read_old_times(ec_fsm_master_t *);
 void ec_fsm_master_state_clear_addresses(ec_fsm_master_t *);
 #ifdef EC_LOOP_CONTROL
@@ -71,9 +81,21 @@ void ec_fsm_master_state_dc_write_offset(ec_fsm_master_t *);
 void ec_fsm_master_state_dc_reset_filter(ec_fsm_master_t *);
 void ec_fsm_master_state_write_sii(ec_fsm_master_t *);
 void ec_fsm_master_state_reboot_slave(ec_fsm_master_t *);
+void ec_fsm_master_state_group_op_request(ec_fsm_master_t *);
+void ec_fsm_master_state_group_op_check(ec_fsm_master_t *);
+
+int ec_fsm_master_action_group_op(ec_fsm_master_t *);
+void ec_fsm_master_group_op_failed(ec_fsm_master_t *);
+void ec_fsm_master_check_op(ec_fsm_master_t *);
 
+void ec_fsm_master_enter_full_scan(ec_fsm_master_t *);
+void ec_fsm_master_enter_incremental_scan(ec_fsm_master_t *);
 void ec_fsm_master_enter_dc_read_old_times(ec_fsm_master_t *);
 void ec_fsm_master_enter_clear_addresses(ec_fsm_master_t *);
+#ifdef EC_LOOP_CONTROL
+void ec_fsm_master_enter_loop_control(ec_fsm_master_t *);
+#endif
+void ec_fsm_master_enter_dc_measure_delays(ec_fsm_master_t *);
 void ec_fsm_master_enter_write_system_times(ec_fsm_master_t *);
 
 /*****************************************************************************/
@@ -131,6 +153,8 @@ void ec_fsm_master_reset(
     }
 
     fsm->rescan_required = 0;
+    fsm->incremental_scan = 0;
+    fsm->scan_position = 0;
 }
 
 /*****************************************************************************/
@@ -265,8 +289,6 @@ void ec_fsm_master_state_broadcast(
         )
 {
     ec_datagram_t *datagram = fsm->datagram;
-    unsigned int i, size;
-    ec_slave_t *slave;
     ec_master_t *master = fsm->master;
 
     // bus topology change?
@@ -276,6 +298,7 @@ void ec_fsm_master_state_broadcast(
         EC_MASTER_INFO(master, "%u slave(s) responding on %s device.\n",
                 fsm->slaves_responding[fsm->dev_idx],
                 ec_device_names[fsm->dev_idx != 0]);
+        ec_master_signal_event(master, EC_EVENT_TOPOLOGY);
     }
 
     if (fsm->link_state[fsm->dev_idx] &&
@@ -317,6 +340,7 @@ void ec_fsm_master_state_broadcast(
             ec_state_string(states, state_str, 1);
             EC_MASTER_INFO(master, "Slave states on %s device: %s.\n",
                     ec_device_names[fsm->dev_idx != 0], state_str);
+            ec_master_signal_event(master, EC_EVENT_AL_STATE);
         }
     } else {
         fsm->slave_states[fsm->dev_idx] = 0x00;
@@ -335,84 +359,42 @@ void ec_fsm_master_state_broadcast(
         if (!master->allow_scan) {
             ec_lock_up(&master->scan_sem);
         } else {
-            unsigned int count = 0, next_dev_slave, ring_position;
-            ec_device_index_t dev_idx;
+            unsigned int count = fsm->slaves_responding[EC_DEVICE_MAIN];
 
             master->scan_busy = 1;
             ec_lock_up(&master->scan_sem);
 
-            // clear all slaves and scan the bus
             fsm->rescan_required = 0;
             fsm->idle = 0;
             fsm->scan_jiffies = jiffies;
 
-            ec_master_slaves_not_available(master);
-#ifdef EC_EOE
-            ec_master_eoe_stop(master);
-            ec_master_clear_eoe_handlers(master, 0);
-#endif
-            ec_master_clear_slaves(master);
-            ec_master_clear_sii_images(master);
-
-            ec_lock_down(&master->config_sem);
-            master->config_busy = 0;
-            ec_lock_up(&master->config_sem);
-
-            for (dev_idx = EC_DEVICE_MAIN;
-                    dev_idx < ec_master_num_devices(master); dev_idx++) {
-                count += fsm->slaves_responding[dev_idx];
-            }
-
-            if (!count) {
-                // no slaves present -> finish state machine.
-                master->scan_busy = 0;
-                wake_up_interruptible(&master->scan_queue);
-                ec_fsm_master_restart(fsm);
-                return;
-            }
-
-            size = sizeof(ec_slave_t) * count;
-            if (!(master->slaves =
-                        (ec_slave_t *) kmalloc(size, GFP_KERNEL))) {
-                EC_MASTER_ERR(master, "Failed to allocate %u bytes"
-                        " of slave memory!\n", size);
-                master->scan_busy = 0;
-                wake_up_interruptible(&master->scan_queue);
-                ec_fsm_master_restart(fsm);
+            /* Slaves added to or removed from the end of the bus do not
+             * affect the others, so only scan the changed bus segment, if
+             * the remaining slaves still answer to their ring positions. */
+            if (ec_master_num_devices(master) == 1 && master->slave_count &&
+                    count && count != master->slave_count &&
+                    count <= master->slave_capacity) {
+                EC_MASTER_DBG(master, 1, "Verifying station addresses"
+                        " for incremental bus scan.\n");
+                fsm->scan_position = min(count, master->slave_count) - 1;
+                ec_datagram_aprd(fsm->datagram, fsm->scan_position,
+                        0x0010, 2);
+                ec_datagram_zero(fsm->datagram);
+                fsm->datagram->device_index = EC_DEVICE_MAIN;
+                fsm->retries = EC_FSM_RETRIES;
+                fsm->state = ec_fsm_master_state_verify_address;
                 return;
             }
 
-            // init slaves
-            dev_idx = EC_DEVICE_MAIN;
-            next_dev_slave = fsm->slaves_responding[dev_idx];
-            ring_position = 0;
-            for (i = 0; i < count; i++, ring_position++) {
-                slave = master->slaves + i;
-                while (i >= next_dev_slave) {
-                    dev_idx++;
-                    next_dev_slave += fsm->slaves_responding[dev_idx];
-                    ring_position = 0;
-                }
-
-                ec_slave_init(slave, master, dev_idx, ring_position, i + 1);
-
-                // do not force reconfiguration in operation phase to avoid
-                // unnecesssary process data interruptions
-                if (master->phase != EC_OPERATION) {
-                    slave->force_config = 1;
-                }
-            }
-            master->slave_count = count;
-            master->fsm_slave = master->slaves;
-
-            ec_master_slaves_available(master);
-            ec_fsm_master_enter_dc_read_old_times(fsm);
+            ec_fsm_master_enter_full_scan(fsm);
             return;
         }
     }
 
     if (master->slave_count) {
 
+        ec_fsm_master_check_op(fsm);
+
         // application applied configurations
         if (master->config_changed) {
             master->config_changed = 0;
@@ -423,6 +405,8 @@ void ec_fsm_master_state_broadcast(
             fsm->slave = master->slaves; // begin with first slave
             ec_fsm_master_enter_write_system_times(fsm);
 
+        } else if (ec_fsm_master_action_group_op(fsm)) {
+            // all configured slaves are requested to go to OP at once
         } else {
             // fetch state from first slave
             fsm->slave = master->slaves;
@@ -769,6 +753,253 @@ void ec_fsm_master_state_read_al_status(
 
 /*****************************************************************************/
 
+/** Check, if the slaves can be brought to OP at once, and start the grouped
+ * AL state transition.
+ *
+ * If a slave can not take part in the grouped transition, the waiting slaves
+ * are released to change their states individually.
+ *
+ * \return non-zero, if the grouped transition was started.
+ */
+int ec_fsm_master_action_group_op(
+        ec_fsm_master_t *fsm /**< Master state machine. */
+        )
+{
+    ec_master_t *master = fsm->master;
+    ec_slave_t *slave;
+    unsigned int waiting = 0, busy;
+
+    if (!master->group_op) {
+        return 0;
+    }
+
+    ec_lock_down(&master->config_sem);
+    busy = master->config_busy;
+    ec_lock_up(&master->config_sem);
+
+    for (slave = master->slaves;
+            slave < master->slaves + master->slave_count; slave++) {
+        if (slave->error_flag
+                || slave->requested_state != EC_SLAVE_STATE_OP
+                || (slave->group_op
+                    && slave->current_state != EC_SLAVE_STATE_SAFEOP)) {
+            EC_SLAVE_DBG(slave, 1, "Can not take part in the grouped"
+                    " transition to OP.\n");
+            ec_fsm_master_group_op_failed(fsm);
+            return 0;
+        }
+
+        if (slave->group_op) {
+            waiting++;
+        } else if (slave->current_state != EC_SLAVE_STATE_OP) {
+            busy = 1; // not configured yet
+        }
+    }
+
+    if (busy || !waiting) {
+        return 0;
+    }
+
+    EC_MASTER_DBG(master, 1, "Requesting OP for %u slaves at once.\n",
+            waiting);
+
+    fsm->idle = 0;
+    fsm->group_jiffies = jiffies;
+    ec_datagram_bwr(fsm->datagram, 0x0120, 2);
+    EC_WRITE_U16(fsm->datagram->data, EC_SLAVE_STATE_OP);
+    fsm->datagram->device_index = EC_DEVICE_MAIN;
+    fsm->retries = EC_FSM_RETRIES;
+    fsm->state = ec_fsm_master_state_group_op_request;
+    return 1;
+}
+
+/*****************************************************************************/
+
+/** Release the slaves waiting for the grouped transition to OP.
+ *
+ * The slave state machines then request OP for every slave, that did not
+ * reach it.
+ */
+void ec_fsm_master_group_op_failed(
+        ec_fsm_master_t *fsm /**< Master state machine. */
+        )
+{
+    ec_master_t *master = fsm->master;
+    ec_slave_t *slave;
+
+    master->group_op = 0;
+
+    for (slave = master->slaves;
+            slave < master->slaves + master->slave_count; slave++) {
+        if (slave->group_op) {
+            slave->group_op = 0;
+            slave->group_op_failed = 1;
+        }
+    }
+}
+
+/*****************************************************************************/
+
+/** Master state: GROUP OP REQUEST.
+ *
+ * Checks the broadcast write to the AL control register.
+ */
+void ec_fsm_master_state_group_op_request(
+        ec_fsm_master_t *fsm /**< Master state machine. */
+        )
+{
+    ec_master_t *master = fsm->master;
+    ec_datagram_t *datagram = fsm->datagram;
+
+    if (datagram->state == EC_DATAGRAM_TIMED_OUT && fsm->retries--) {
+        return;
+    }
+
+    if (datagram->state != EC_DATAGRAM_RECEIVED) {
+        EC_MASTER_ERR(master, "Failed to receive grouped AL control"
+                " datagram: ");
+        ec_datagram_print_state(datagram);
+        ec_fsm_master_group_op_failed(fsm);
+        ec_fsm_master_restart(fsm);
+        return;
+    }
+
+    if (datagram->working_counter != master->slave_count) {
+        EC_MASTER_WARN(master, "Grouped OP request reached %u of %u"
+                " slaves.\n", datagram->working_counter, master->slave_count);
+        ec_fsm_master_group_op_failed(fsm);
+        ec_fsm_master_restart(fsm);
+        return;
+    }
+
+    ec_datagram_brd(datagram, 0x0130, 2);
+    ec_datagram_zero(datagram);
+    datagram->device_index = EC_DEVICE_MAIN;
+    fsm->retries = EC_FSM_RETRIES;
+    fsm->state = ec_fsm_master_state_group_op_check;
+}
+
+/*****************************************************************************/
+
+/** Master state: GROUP OP CHECK.
+ *
+ * Polls the ORed AL states of all slaves, until all slaves are in OP.
+ */
+void ec_fsm_master_state_group_op_check(
+        ec_fsm_master_t *fsm /**< Master state machine. */
+        )
+{
+    ec_master_t *master = fsm->master;
+    ec_datagram_t *datagram = fsm->datagram;
+    ec_slave_t *slave;
+    uint8_t states;
+
+    if (datagram->state == EC_DATAGRAM_TIMED_OUT && fsm->retries--) {
+        return;
+    }
+
+    if (datagram->state != EC_DATAGRAM_RECEIVED) {
+        EC_MASTER_ERR(master, "Failed to receive grouped AL status"
+                " datagram: ");
+        ec_datagram_print_state(datagram);
+        ec_fsm_master_group_op_failed(fsm);
+        ec_fsm_master_restart(fsm);
+        return;
+    }
+
+    if (datagram->working_counter != master->slave_count) {
+        EC_MASTER_WARN(master, "%u of %u slaves responded to the grouped"
+                " AL status query.\n", datagram->working_counter,
+                master->slave_count);
+        ec_fsm_master_group_op_failed(fsm);
+        ec_fsm_master_restart(fsm);
+        return;
+    }
+
+    states = EC_READ_U8(datagram->data);
+
+    if (states == EC_SLAVE_STATE_OP) {
+        for (slave = master->slaves;
+                slave < master->slaves + master->slave_count; slave++) {
+            slave->group_op = 0;
+            ec_slave_set_al_status(slave, EC_SLAVE_STATE_OP);
+        }
+        master->group_op = 0;
+        master->op_grouped = 1;
+        EC_MASTER_DBG(master, 1, "Grouped transition to OP took %u ms.\n",
+                (unsigned int) ((jiffies - fsm->group_jiffies) * 1000 / HZ));
+        ec_fsm_master_restart(fsm);
+        return;
+    }
+
+    if (states & EC_SLAVE_STATE_ACK_ERR) {
+        char state_str[EC_STATE_STRING_SIZE];
+        ec_state_string(states, state_str, 0);
+        EC_MASTER_WARN(master, "Grouped transition to OP failed"
+                " (slave states %s). Changing states individually.\n",
+                state_str);
+        ec_fsm_master_group_op_failed(fsm);
+        ec_fsm_master_restart(fsm);
+        return;
+    }
+
+    if (jiffies - fsm->group_jiffies >= EC_GROUP_OP_TIMEOUT * HZ) {
+        EC_MASTER_WARN(master, "Timeout while waiting for the grouped"
+                " transition to OP. Changing states individually.\n");
+        ec_fsm_master_group_op_failed(fsm);
+        ec_fsm_master_restart(fsm);
+        return;
+    }
+
+    // still changing state: check again
+    ec_datagram_brd(datagram, 0x0130, 2);
+    ec_datagram_zero(datagram);
+    datagram->device_index = EC_DEVICE_MAIN;
+    fsm->retries = EC_FSM_RETRIES;
+}
+
+/*****************************************************************************/
+
+/** Check, if all slaves reached OP since the last activation.
+ *
+ * Uses the ORed slave states of the last broadcast read.
+ */
+void ec_fsm_master_check_op(
+        ec_fsm_master_t *fsm /**< Master state machine. */
+        )
+{
+    ec_master_t *master = fsm->master;
+    ec_device_index_t dev_idx;
+    unsigned int responding = 0;
+
+    if (!master->op_pending) {
+        return;
+    }
+
+    for (dev_idx = EC_DEVICE_MAIN;
+            dev_idx < ec_master_num_devices(master); dev_idx++) {
+        if (!fsm->slaves_responding[dev_idx]) {
+            continue;
+        }
+        if (fsm->slave_states[dev_idx] != EC_SLAVE_STATE_OP) {
+            return;
+        }
+        responding += fsm->slaves_responding[dev_idx];
+    }
+
+    if (responding != master->slave_count) {
+        return;
+    }
+
+    master->op_pending = 0;
+    master->op_duration = (jiffies - master->activate_jiffies) * 1000 / HZ;
+    EC_MASTER_INFO(master, "All %u slaves in OP %u ms after activation%s.\n",
+            master->slave_count, master->op_duration,
+            master->op_grouped ? " (grouped transition)" : "");
+}
+
+/*****************************************************************************/
+
 /** Master state: REBOOT SLAVE.
  */
 void ec_fsm_master_state_reboot_slave(
@@ -794,6 +1025,211 @@ void ec_fsm_master_state_reboot_slave(
 
 /*****************************************************************************/
 
+/** Clear all slaves and scan the whole bus.
+ */
+void ec_fsm_master_enter_full_scan(
+        ec_fsm_master_t *fsm /**< Master state machine. */
+        )
+{
+    ec_master_t *master = fsm->master;
+    unsigned int i, size, count = 0, next_dev_slave, ring_position;
+    ec_device_index_t dev_idx;
+    ec_slave_t *slaves, *slave;
+
+    fsm->incremental_scan = 0;
+
+    ec_master_slaves_not_available(master);
+#ifdef EC_EOE
+    ec_master_eoe_stop(master);
+    ec_master_clear_eoe_handlers(master, 0);
+#endif
+    ec_master_clear_slaves(master);
+    ec_master_clear_sii_images(master);
+
+    ec_lock_down(&master->config_sem);
+    master->config_busy = 0;
+    ec_lock_up(&master->config_sem);
+
+    for (dev_idx = EC_DEVICE_MAIN;
+            dev_idx < ec_master_num_devices(master); dev_idx++) {
+        count += fsm->slaves_responding[dev_idx];
+    }
+
+    if (!count) {
+        // no slaves present -> finish state machine.
+        master->scan_busy = 0;
+        wake_up_interruptible(&master->scan_queue);
+        ec_master_signal_event(master, EC_EVENT_TOPOLOGY);
+        ec_fsm_master_restart(fsm);
+        return;
+    }
+
+    // reserve spare slaves for appending slaves incrementally
+    size = sizeof(ec_slave_t) * (count + EC_SPARE_SLAVES);
+    if (!(slaves = (ec_slave_t *) kmalloc(size, GFP_KERNEL))) {
+        size = sizeof(ec_slave_t) * count;
+        slaves = (ec_slave_t *) kmalloc(size, GFP_KERNEL);
+        master->slave_capacity = count;
+    } else {
+        master->slave_capacity = count + EC_SPARE_SLAVES;
+    }
+    if (!slaves) {
+        EC_MASTER_ERR(master, "Failed to allocate %u bytes"
+                " of slave memory!\n", size);
+        master->slave_capacity = 0;
+        master->scan_busy = 0;
+        wake_up_interruptible(&master->scan_queue);
+        ec_fsm_master_restart(fsm);
+        return;
+    }
+
+    // init slaves
+    dev_idx = EC_DEVICE_MAIN;
+    next_dev_slave = fsm->slaves_responding[dev_idx];
+    ring_position = 0;
+    for (i = 0; i < count; i++, ring_position++) {
+        slave = slaves + i;
+        while (i >= next_dev_slave) {
+            dev_idx++;
+            next_dev_slave += fsm->slaves_responding[dev_idx];
+            ring_position = 0;
+        }
+
+        ec_slave_init(slave, master, dev_idx, ring_position, i + 1);
+
+        // do not force reconfiguration in operation phase to avoid
+        // unnecesssary process data interruptions
+        if (master->phase != EC_OPERATION) {
+            slave->force_config = 1;
+        }
+    }
+    ec_master_set_slaves(master, slaves, count);
+    master->fsm_slave = master->slaves;
+
+    ec_master_slaves_available(master);
+    ec_fsm_master_enter_dc_read_old_times(fsm);
+}
+
+/*****************************************************************************/
+
+/** Master state: VERIFY ADDRESS.
+ *
+ * Checks, that the last slave in front of the changed bus segment still
+ * holds its station address, and that the first new slave does not hold
+ * one of the addresses in use. A slave inserted into or removed from the
+ * middle of the bus shifts the ring positions of all slaves behind it, so
+ * it is detected by the first check without reading the address of every
+ * slave.
+ */
+void ec_fsm_master_state_verify_address(
+        ec_fsm_master_t *fsm /**< Master state machine. */
+        )
+{
+    ec_master_t *master = fsm->master;
+    ec_datagram_t *datagram = fsm->datagram;
+    unsigned int count = fsm->slaves_responding[EC_DEVICE_MAIN];
+    unsigned int position = fsm->scan_position;
+    uint16_t address;
+
+    if (datagram->state == EC_DATAGRAM_TIMED_OUT && fsm->retries--) {
+        return;
+    }
+
+    if (datagram->state != EC_DATAGRAM_RECEIVED ||
+            datagram->working_counter != 1) {
+        EC_MASTER_DBG(master, 1, "Failed to read station address"
+                " of slave %u.\n", position);
+        goto full_scan;
+    }
+
+    address = EC_READ_U16(datagram->data);
+    if (position < master->slave_count) {
+        if (address != master->slaves[position].station_address) {
+            EC_MASTER_DBG(master, 1, "Slave %u has station address 0x%04X,"
+                    " expected 0x%04X.\n", position, address,
+                    master->slaves[position].station_address);
+            goto full_scan;
+        }
+    } else if (address && address != position + 1 && address <= count) {
+        EC_MASTER_DBG(master, 1, "New slave %u has station address"
+                " 0x%04X in use.\n", position, address);
+        goto full_scan;
+    }
+
+    if (position < master->slave_count && position + 1 < count) {
+        // check the first new slave, too
+        fsm->scan_position++;
+        ec_datagram_aprd(datagram, fsm->scan_position, 0x0010, 2);
+        ec_datagram_zero(datagram);
+        fsm->retries = EC_FSM_RETRIES;
+        return;
+    }
+
+    ec_fsm_master_enter_incremental_scan(fsm);
+    return;
+
+full_scan:
+    EC_MASTER_INFO(master, "Bus changed in front of the new or removed"
+            " slaves. Scanning whole bus.\n");
+    ec_fsm_master_enter_full_scan(fsm);
+}
+
+/*****************************************************************************/
+
+/** Scan only the slaves added to or removed from the end of the bus.
+ *
+ * The remaining slaves keep their state and their attached configurations
+ * and only refresh their port states for the new topology.
+ */
+void ec_fsm_master_enter_incremental_scan(
+        ec_fsm_master_t *fsm /**< Master state machine. */
+        )
+{
+    ec_master_t *master = fsm->master;
+    unsigned int i, count = fsm->slaves_responding[EC_DEVICE_MAIN];
+    ec_slave_t *slave;
+
+    EC_MASTER_INFO(master, "Scanning %s slaves %u to %u only.\n",
+            count > master->slave_count ? "new" : "removed",
+            min(count, master->slave_count),
+            max(count, master->slave_count) - 1);
+
+    fsm->incremental_scan = 1;
+
+    ec_master_slaves_not_available(master);
+#ifdef EC_EOE
+    ec_master_eoe_stop(master);
+#endif
+
+    for (slave = master->slaves;
+            slave < master->slaves + min(count, master->slave_count);
+            slave++) {
+        slave->scan_required = 1;
+        slave->scan_ports_only = 1;
+    }
+
+    if (count < master->slave_count) {
+        ec_master_remove_slaves(master, count);
+    } else {
+        for (i = master->slave_count; i < count; i++) {
+            slave = master->slaves + i;
+            ec_slave_init(slave, master, EC_DEVICE_MAIN, i, i + 1);
+
+            // do not force reconfiguration in operation phase to avoid
+            // unnecesssary process data interruptions
+            if (master->phase != EC_OPERATION) {
+                slave->force_config = 1;
+            }
+        }
+        ec_master_set_slaves(master, master->slaves, count);
+    }
+
+    ec_master_slaves_available(master);
+    ec_fsm_master_enter_dc_read_old_times(fsm);
+}
+
+/*****************************************************************************/
+
 /** Start reading old timestamps from slaves.
  */
 void ec_fsm_master_enter_dc_read_old_times(
@@ -859,7 +1295,16 @@ void ec_fsm_master_state_dc_read_old_times(
         }
 
         fsm->slave = master->slaves;
-        ec_fsm_master_enter_clear_addresses(fsm);
+        if (fsm->incremental_scan) {
+            // the kept slaves hold their addresses, new ones are verified
+#ifdef EC_LOOP_CONTROL
+            ec_fsm_master_enter_loop_control(fsm);
+#else
+            ec_fsm_master_enter_dc_measure_delays(fsm);
+#endif
+        } else {
+            ec_fsm_master_enter_clear_addresses(fsm);
+        }
     }
 }
 
@@ -1061,11 +1506,16 @@ void ec_fsm_master_state_scan_slave(
         }
     }
 
-    EC_MASTER_INFO(master, "Bus scanning completed in %lu ms.\n",
-            (jiffies - fsm->scan_jiffies) * 1000 / HZ);
+    master->scan_duration = (jiffies - fsm->scan_jiffies) * 1000 / HZ;
+    master->scan_incremental = fsm->incremental_scan;
+    fsm->incremental_scan = 0;
+    EC_MASTER_INFO(master, "%s scanning completed in %u ms.\n",
+            master->scan_incremental ? "Incremental bus" : "Bus",
+            master->scan_duration);
 
     master->scan_busy = 0;
     wake_up_interruptible(&master->scan_queue);
+    ec_master_signal_event(master, EC_EVENT_TOPOLOGY);
 
     // Attach slave configurations
     ec_master_attach_slave_configs(master);
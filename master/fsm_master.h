@@ -80,6 +80,13 @@ struct ec_fsm_master {
                                                           responding slaves
                                                           for every device. */
     unsigned int rescan_required; /**< A bus rescan is required. */
+    unsigned int incremental_scan; /**< The running bus scan only covers the
+                                     slaves added to or removed from the end
+                                     of the bus. */
+    unsigned int scan_position; /**< Ring position to verify before an
+                                  incremental bus scan. */
+    unsigned long group_jiffies; /**< Beginning of the grouped AL state
+                                   transition. */
     ec_slave_state_t slave_states[EC_MAX_NUM_DEVICES]; /**< AL states of
                                                          responding slaves for
                                                          every device. */
@@ -67,7 +67,9 @@ struct ec_fsm_sii
     void (*state)(ec_fsm_sii_t *, ec_datagram_t *); /**< SII state function */
     uint16_t word_offset; /**< input: word offset in SII */
     ec_fsm_sii_addressing_t mode; /**< reading via APRD or NPRD */
-    uint8_t value[4]; /**< raw SII value (32bit) */
+    uint8_t value[8]; /**< raw SII value (32bit, or 64bit if supported) */
+    uint8_t value_size; /**< Number of valid bytes in \a value (4 or 8,
+                          depending on the slave's EEPROM read size). */
     unsigned long jiffies_start; /**< Start timestamp. */
     uint8_t check_once_more; /**< one more try after timeout */
     uint8_t eeprom_load_retry; /**< waiting for eeprom to be loaded */
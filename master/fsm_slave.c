@@ -42,17 +42,29 @@
 
 /*****************************************************************************/
 
+/** Maximum number of SDO requests processed back to back, before the other
+ * requests of the slave get a turn.
+ */
+#define EC_FSM_SLAVE_MAX_SDO_BURST 16
+
+/*****************************************************************************/
+
+void ec_fsm_slave_request_done(ec_slave_t *);
 void ec_fsm_slave_state_idle(ec_fsm_slave_t *, ec_datagram_t *);
 void ec_fsm_slave_state_ready(ec_fsm_slave_t *, ec_datagram_t *);
 int ec_fsm_slave_action_scan(ec_fsm_slave_t *, ec_datagram_t *);
 void ec_fsm_slave_state_scan(ec_fsm_slave_t *, ec_datagram_t *);
 int ec_fsm_slave_action_config(ec_fsm_slave_t *, ec_datagram_t *);
+int ec_fsm_slave_config_pending(const ec_slave_t *);
+int ec_fsm_slave_dict_fetch_required(const ec_slave_t *);
+int ec_fsm_slave_other_requests_pending(const ec_fsm_slave_t *);
 void ec_fsm_slave_state_acknowledge(ec_fsm_slave_t *, ec_datagram_t *);
 void ec_fsm_slave_state_config(ec_fsm_slave_t *, ec_datagram_t *);
 int ec_fsm_slave_action_process_dict(ec_fsm_slave_t *, ec_datagram_t *);
 void ec_fsm_slave_state_dict_request(ec_fsm_slave_t *, ec_datagram_t *);
 int ec_fsm_slave_action_process_config_sdo(ec_fsm_slave_t *, ec_datagram_t *);
 int ec_fsm_slave_action_process_sdo(ec_fsm_slave_t *, ec_datagram_t *);
+int ec_fsm_slave_action_next_sdo(ec_fsm_slave_t *, ec_datagram_t *);
 void ec_fsm_slave_state_sdo_request(ec_fsm_slave_t *, ec_datagram_t *);
 int ec_fsm_slave_action_process_reg(ec_fsm_slave_t *, ec_datagram_t *);
 void ec_fsm_slave_state_reg_request(ec_fsm_slave_t *, ec_datagram_t *);
@@ -82,6 +94,8 @@ void ec_fsm_slave_init(
     fsm->state = ec_fsm_slave_state_idle;
     fsm->datagram = NULL;
     fsm->sdo_request = NULL;
+    fsm->sdo_count = 0;
+    fsm->sdo_jiffies_start = 0;
     fsm->reg_request = NULL;
     fsm->foe_request = NULL;
     fsm->soe_request = NULL;
@@ -111,6 +125,21 @@ void ec_fsm_slave_init(
 
 /*****************************************************************************/
 
+/** Signals the completion of a request of the slave.
+ *
+ * Wakes up the waiting ioctl() callers and posts an EC_EVENT_REQUEST to the
+ * applications.
+ */
+void ec_fsm_slave_request_done(
+        ec_slave_t *slave /**< EtherCAT slave. */
+        )
+{
+    wake_up_all(&slave->master->request_queue);
+    ec_master_post_event(slave->master, EC_EVENT_REQUEST);
+}
+
+/*****************************************************************************/
+
 /** Destructor.
  */
 void ec_fsm_slave_clear(
@@ -125,39 +154,39 @@ void ec_fsm_slave_clear(
 
     if (fsm->sdo_request) {
         fsm->sdo_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&fsm->slave->master->request_queue);
+        ec_fsm_slave_request_done(fsm->slave);
     }
 
     if (fsm->reg_request) {
         fsm->reg_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&fsm->slave->master->request_queue);
+        ec_fsm_slave_request_done(fsm->slave);
     }
 
     if (fsm->foe_request) {
         fsm->foe_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&fsm->slave->master->request_queue);
+        ec_fsm_slave_request_done(fsm->slave);
     }
 
     if (fsm->soe_request) {
         fsm->soe_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&fsm->slave->master->request_queue);
+        ec_fsm_slave_request_done(fsm->slave);
     }
 
 #ifdef EC_EOE
     if (fsm->eoe_request) {
         fsm->eoe_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&fsm->slave->master->request_queue);
+        ec_fsm_slave_request_done(fsm->slave);
     }
 #endif
 
     if (fsm->mbg_request) {
         fsm->mbg_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&fsm->slave->master->request_queue);
+        ec_fsm_slave_request_done(fsm->slave);
     }
 
     if (fsm->dict_request) {
         fsm->dict_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&fsm->slave->master->request_queue);
+        ec_fsm_slave_request_done(fsm->slave);
     }
 
     // clear sub-state machines
@@ -295,7 +324,8 @@ void ec_fsm_slave_state_scan(
     slave->valid_mbox_data = 1;
 
 #ifdef EC_EOE
-    if (slave->sii_image && (slave->sii_image->sii.mailbox_protocols & EC_MBOX_EOE)) {
+    if (!slave->scan_ports_only && slave->sii_image &&
+            (slave->sii_image->sii.mailbox_protocols & EC_MBOX_EOE)) {
         // try to connect to existing eoe handler, 
         // otherwise try to create a new one (if master not active)
         if (ec_slave_reconnect_to_eoe_handler(slave) == 0) {
@@ -318,11 +348,42 @@ void ec_fsm_slave_state_scan(
 
     // disable processing after scan, to wait for master FSM to be ready again
     slave->scan_required = 0;
+    slave->scan_ports_only = 0;
     fsm->state = ec_fsm_slave_state_idle;
 }
 
 /*****************************************************************************/
 
+/** Checks, if an error has to be acknowledged or the slave has to be
+ * configured.
+ *
+ * \return non-zero, if ec_fsm_slave_action_config() would start an action.
+ */
+int ec_fsm_slave_config_pending(
+        const ec_slave_t *slave /**< EtherCAT slave. */
+        )
+{
+    if (slave->error_flag) {
+        return 0;
+    }
+
+    // Check, if new slave state has to be acknowledged
+    if (slave->current_state & EC_SLAVE_STATE_ACK_ERR) {
+        return 1;
+    }
+
+    // Is the slave waiting for the grouped transition to OP?
+    if (slave->group_op) {
+        return 0;
+    }
+
+    // Does the slave have to be configured?
+    return slave->current_state != slave->requested_state
+        || slave->force_config;
+}
+
+/*****************************************************************************/
+
 /** Check for pending configuration.
  *
  * \return non-zero, if configuration is started.
@@ -334,7 +395,10 @@ int ec_fsm_slave_action_config(
 {
     ec_slave_t *slave = fsm->slave;
 
-    if (slave->error_flag) {
+    if (!ec_fsm_slave_config_pending(slave)) {
+        if (!slave->error_flag && !slave->group_op) {
+            slave->group_op_failed = 0;
+        }
         return 0;
     }
 
@@ -346,42 +410,45 @@ int ec_fsm_slave_action_config(
         return 1;
     }
 
-    // Does the slave have to be configured?
-    if (slave->current_state != slave->requested_state
-                || slave->force_config) {
-
-        if (slave->master->debug_level) {
-            char old_state[EC_STATE_STRING_SIZE],
-                 new_state[EC_STATE_STRING_SIZE];
-            ec_state_string(slave->current_state, old_state, 0);
-            ec_state_string(slave->requested_state, new_state, 0);
-            EC_SLAVE_DBG(slave, 1, "Changing state from %s to %s%s.\n",
-                    old_state, new_state,
-                    slave->force_config ? " (forced)" : "");
-        }
+    // Configure the slave
+    if (slave->master->debug_level) {
+        char old_state[EC_STATE_STRING_SIZE],
+             new_state[EC_STATE_STRING_SIZE];
+        ec_state_string(slave->current_state, old_state, 0);
+        ec_state_string(slave->requested_state, new_state, 0);
+        EC_SLAVE_DBG(slave, 1, "Changing state from %s to %s%s.\n",
+                old_state, new_state,
+                slave->force_config ? " (forced)" : "");
+    }
 
-        ec_lock_down(&slave->master->config_sem);
-        ++slave->master->config_busy;
-        ec_lock_up(&slave->master->config_sem);
+    ec_lock_down(&slave->master->config_sem);
+    ++slave->master->config_busy;
+    ec_lock_up(&slave->master->config_sem);
 
-        fsm->state = ec_fsm_slave_state_config;
+    fsm->state = ec_fsm_slave_state_config;
+    if (!slave->force_config
+            && slave->current_state == EC_SLAVE_STATE_SAFEOP
+            && slave->requested_state == EC_SLAVE_STATE_OP
+            && slave->group_op_failed) {
+        // the slave is configured, but the grouped transition to OP
+        // failed; only request OP for this slave
+        ec_fsm_slave_config_quick_start(&fsm->fsm_slave_config);
+    } else
 #ifdef EC_QUICK_OP
-        if (!slave->force_config
-                && slave->current_state == EC_SLAVE_STATE_SAFEOP
-                && slave->requested_state == EC_SLAVE_STATE_OP
-                && slave->last_al_error == 0x001B) {
-            // last error was a sync watchdog timeout; assume a comms
-            // interruption and request a quick transition back to OP
-            ec_fsm_slave_config_quick_start(&fsm->fsm_slave_config);
-        } else
+    if (!slave->force_config
+            && slave->current_state == EC_SLAVE_STATE_SAFEOP
+            && slave->requested_state == EC_SLAVE_STATE_OP
+            && slave->last_al_error == 0x001B) {
+        // last error was a sync watchdog timeout; assume a comms
+        // interruption and request a quick transition back to OP
+        ec_fsm_slave_config_quick_start(&fsm->fsm_slave_config);
+    } else
 #endif
-        {
-            ec_fsm_slave_config_start(&fsm->fsm_slave_config);
-        }
-        fsm->state(fsm, datagram); // execute immediately
-        return 1;
+    {
+        ec_fsm_slave_config_start(&fsm->fsm_slave_config);
     }
-    return 0;
+    fsm->state(fsm, datagram); // execute immediately
+    return 1;
 }
 
 /*****************************************************************************/
@@ -441,6 +508,30 @@ void ec_fsm_slave_state_config(
 
 /*****************************************************************************/
 
+/** Checks, if the SDO dictionary has to be fetched on startup.
+ *
+ * \return non-zero, if the dictionary has to be fetched.
+ */
+int ec_fsm_slave_dict_fetch_required(
+        const ec_slave_t *slave /**< EtherCAT slave. */
+        )
+{
+#if EC_SKIP_SDO_DICT
+    return 0;
+#else
+    return slave->sii_image
+        && !slave->sdo_dictionary_fetched
+        && slave->current_state != EC_SLAVE_STATE_INIT
+        && slave->current_state != EC_SLAVE_STATE_UNKNOWN
+        && !(slave->current_state & EC_SLAVE_STATE_ACK_ERR)
+        && (slave->sii_image->sii.mailbox_protocols & EC_MBOX_COE)
+        && !(slave->sii_image->sii.has_general
+                && !slave->sii_image->sii.coe_details.enable_sdo_info);
+#endif
+}
+
+/*****************************************************************************/
+
 /** Check for pending SDO dictionary reads.
  *
  * \return non-zero, if an SDO dictionary read is started.
@@ -462,7 +553,7 @@ int ec_fsm_slave_action_process_dict(
         if (!slave->sii_image) {
             EC_SLAVE_ERR(slave, "Slave not ready to process dictionary request\n");
             request->state = EC_INT_REQUEST_FAILURE;
-            wake_up_all(&slave->master->request_queue);
+            ec_fsm_slave_request_done(slave);
             fsm->state = ec_fsm_slave_state_idle;
             return 1;
         }
@@ -474,7 +565,7 @@ int ec_fsm_slave_action_process_dict(
             EC_SLAVE_INFO(slave, "Aborting dictionary request,"
                             " slave does not support SDO Info.\n");
             request->state = EC_INT_REQUEST_SUCCESS;
-            wake_up_all(&slave->master->request_queue);
+            ec_fsm_slave_request_done(slave);
             fsm->dict_request = NULL;
             fsm->state = ec_fsm_slave_state_ready;
             return 1;
@@ -485,7 +576,7 @@ int ec_fsm_slave_action_process_dict(
             EC_SLAVE_DBG(slave, 1, "Aborting dictionary request,"
                             " dictionary already uploaded.\n");
             request->state = EC_INT_REQUEST_SUCCESS;
-            wake_up_all(&slave->master->request_queue);
+            ec_fsm_slave_request_done(slave);
             fsm->dict_request = NULL;
             fsm->state = ec_fsm_slave_state_ready;
             return 1;
@@ -495,7 +586,7 @@ int ec_fsm_slave_action_process_dict(
             EC_SLAVE_WARN(slave, "Aborting dictionary request,"
                     " slave has error flag set.\n");
             request->state = EC_INT_REQUEST_FAILURE;
-            wake_up_all(&slave->master->request_queue);
+            ec_fsm_slave_request_done(slave);
             fsm->state = ec_fsm_slave_state_idle;
             return 1;
         }
@@ -504,7 +595,7 @@ int ec_fsm_slave_action_process_dict(
             EC_SLAVE_WARN(slave, "Aborting dictionary request,"
                     " slave is in INIT.\n");
             request->state = EC_INT_REQUEST_FAILURE;
-            wake_up_all(&slave->master->request_queue);
+            ec_fsm_slave_request_done(slave);
             fsm->state = ec_fsm_slave_state_idle;
             return 1;
         }
@@ -523,18 +614,7 @@ int ec_fsm_slave_action_process_dict(
     }
 
     // Otherwise check if it's time to fetch the dictionary on startup.
-#if EC_SKIP_SDO_DICT
-    return 0;
-#else
-    if (!slave->sii_image
-            || slave->sdo_dictionary_fetched
-            || slave->current_state == EC_SLAVE_STATE_INIT
-            || slave->current_state == EC_SLAVE_STATE_UNKNOWN
-            || slave->current_state & EC_SLAVE_STATE_ACK_ERR
-            || !(slave->sii_image->sii.mailbox_protocols & EC_MBOX_COE)
-            || (slave->sii_image->sii.has_general
-                    && !slave->sii_image->sii.coe_details.enable_sdo_info)
-            ) {
+    if (!ec_fsm_slave_dict_fetch_required(slave)) {
         return 0;
     }
 
@@ -548,7 +628,6 @@ int ec_fsm_slave_action_process_dict(
     ec_fsm_coe_dictionary(&fsm->fsm_coe, slave);
     ec_fsm_coe_exec(&fsm->fsm_coe, datagram); // execute immediately
     return 1;
-#endif
 }
 
 /*****************************************************************************/
@@ -576,7 +655,7 @@ void ec_fsm_slave_state_dict_request(
         }
 #endif
         request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->dict_request = NULL;
         fsm->state = ec_fsm_slave_state_ready;
         return;
@@ -596,7 +675,7 @@ void ec_fsm_slave_state_dict_request(
     ec_slave_attach_pdo_names(slave);
 
     request->state = EC_INT_REQUEST_SUCCESS;
-    wake_up_all(&slave->master->request_queue);
+    ec_fsm_slave_request_done(slave);
     fsm->dict_request = NULL;
     fsm->state = ec_fsm_slave_state_ready;
 }
@@ -642,6 +721,9 @@ int ec_fsm_slave_action_process_config_sdo(
 
             request->state = EC_INT_REQUEST_BUSY;
             EC_SLAVE_DBG(slave, 1, "Processing internal SDO request...\n");
+            if (!fsm->sdo_count) {
+                fsm->sdo_jiffies_start = jiffies;
+            }
             fsm->sdo_request = request;
             fsm->state = ec_fsm_slave_state_sdo_request;
             ec_fsm_coe_transfer(&fsm->fsm_coe, slave, request);
@@ -787,7 +869,7 @@ int ec_fsm_slave_action_process_sdo(
         EC_SLAVE_WARN(slave, "Aborting SDO request,"
                 " slave has error flag set.\n");
         request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
     }
@@ -795,13 +877,16 @@ int ec_fsm_slave_action_process_sdo(
     if (slave->current_state == EC_SLAVE_STATE_INIT) {
         EC_SLAVE_WARN(slave, "Aborting SDO request, slave is in INIT.\n");
         request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
     }
 
     fsm->sdo_request = request;
     request->state = EC_INT_REQUEST_BUSY;
+    if (!fsm->sdo_count) {
+        fsm->sdo_jiffies_start = jiffies;
+    }
 
     // Found pending SDO request. Execute it!
     EC_SLAVE_DBG(slave, 1, "Processing SDO request...\n");
@@ -815,6 +900,70 @@ int ec_fsm_slave_action_process_sdo(
 
 /*****************************************************************************/
 
+/** Checks for pending requests, that are not SDO requests.
+ *
+ * \return non-zero, if a scan, configuration, dictionary, register, FoE,
+ *         SoE, EoE or MBox Gateway request is pending.
+ */
+int ec_fsm_slave_other_requests_pending(
+        const ec_fsm_slave_t *fsm /**< Slave state machine. */
+        )
+{
+    const ec_slave_t *slave = fsm->slave;
+
+    return slave->scan_required
+        || ec_fsm_slave_config_pending(slave)
+        || !list_empty(&slave->dict_requests)
+        || ec_fsm_slave_dict_fetch_required(slave)
+        || !list_empty(&slave->reg_requests)
+        || !list_empty(&slave->foe_requests)
+        || !list_empty(&slave->soe_requests)
+#ifdef EC_EOE
+        || !list_empty(&slave->eoe_requests)
+#endif
+        || !list_empty(&slave->mbg_requests);
+}
+
+/*****************************************************************************/
+
+/** Check for another pending SDO request and start it immediately.
+ *
+ * Called after an SDO request has finished, so that queued requests of the
+ * slave are processed back to back, without waiting for the next round of
+ * the READY state. The burst ends, if any other request is pending or after
+ * \a EC_FSM_SLAVE_MAX_SDO_BURST requests, so that the READY state can give
+ * the other requests a turn.
+ *
+ * \return non-zero, if an SDO request is processed.
+ */
+int ec_fsm_slave_action_next_sdo(
+        ec_fsm_slave_t *fsm, /**< Slave state machine. */
+        ec_datagram_t *datagram /**< Datagram to use. */
+        )
+{
+    ec_slave_t *slave = fsm->slave;
+    unsigned int duration_ms;
+
+    if (fsm->sdo_count >= EC_FSM_SLAVE_MAX_SDO_BURST
+            || ec_fsm_slave_other_requests_pending(fsm)) {
+        // let the READY state take care
+    } else if (ec_fsm_slave_action_process_config_sdo(fsm, datagram)
+            || ec_fsm_slave_action_process_sdo(fsm, datagram)) {
+        return 1;
+    }
+
+    if (fsm->sdo_count > 1) {
+        duration_ms = jiffies_to_msecs(jiffies - fsm->sdo_jiffies_start);
+        EC_SLAVE_DBG(slave, 1, "Processed %u SDO requests back to back"
+                " in %u ms (%u SDO/s).\n", fsm->sdo_count, duration_ms,
+                duration_ms ? fsm->sdo_count * 1000 / duration_ms : 0);
+    }
+    fsm->sdo_count = 0;
+    return 0;
+}
+
+/*****************************************************************************/
+
 /** Slave state: SDO_REQUEST.
  */
 void ec_fsm_slave_state_sdo_request(
@@ -832,19 +981,19 @@ void ec_fsm_slave_state_sdo_request(
     if (!ec_fsm_coe_success(&fsm->fsm_coe)) {
         EC_SLAVE_ERR(slave, "Failed to process SDO request.\n");
         request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
-        fsm->sdo_request = NULL;
-        fsm->state = ec_fsm_slave_state_ready;
-        return;
+    } else {
+        EC_SLAVE_DBG(slave, 1, "Finished SDO request.\n");
+        request->state = EC_INT_REQUEST_SUCCESS;
     }
 
-    EC_SLAVE_DBG(slave, 1, "Finished SDO request.\n");
-
     // SDO request finished
-    request->state = EC_INT_REQUEST_SUCCESS;
-    wake_up_all(&slave->master->request_queue);
+    ec_fsm_slave_request_done(slave);
     fsm->sdo_request = NULL;
+    fsm->sdo_count++;
     fsm->state = ec_fsm_slave_state_ready;
+
+    // keep the mailbox busy with the next queued request
+    ec_fsm_slave_action_next_sdo(fsm, datagram);
 }
 
 /*****************************************************************************/
@@ -895,7 +1044,7 @@ int ec_fsm_slave_action_process_reg(
         EC_SLAVE_WARN(slave, "Aborting register request,"
                 " slave has error flag set.\n");
         fsm->reg_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->reg_request = NULL;
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
@@ -930,7 +1079,7 @@ int ec_fsm_slave_action_process_reg(
     default:
         EC_SLAVE_WARN(slave, "Aborting register request, unknown direction.\n");
         fsm->reg_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->reg_request = NULL;
         fsm->state = ec_fsm_slave_state_idle;
         return 1;
@@ -964,7 +1113,7 @@ void ec_fsm_slave_state_reg_request(
                 " request datagram: ");
         ec_datagram_print_state(fsm->datagram);
         reg->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->reg_request = NULL;
         fsm->state = ec_fsm_slave_state_ready;
         return;
@@ -985,7 +1134,7 @@ void ec_fsm_slave_state_reg_request(
                 fsm->datagram->working_counter);
     }
 
-    wake_up_all(&slave->master->request_queue);
+    ec_fsm_slave_request_done(slave);
     fsm->reg_request = NULL;
     fsm->state = ec_fsm_slave_state_ready;
 }
@@ -1029,7 +1178,7 @@ int ec_fsm_slave_action_process_foe(
         EC_SLAVE_WARN(slave, "Aborting FoE request,"
                 " slave has error flag set.\n");
         fsm->foe_request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->foe_request = NULL;
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
@@ -1056,6 +1205,7 @@ void ec_fsm_slave_state_foe_request(
 {
     ec_slave_t *slave = fsm->slave;
     ec_foe_request_t *request = fsm->foe_request;
+    unsigned int duration;
 
     if (ec_fsm_foe_exec(&fsm->fsm_foe, datagram)) {
         return;
@@ -1064,18 +1214,20 @@ void ec_fsm_slave_state_foe_request(
     if (!ec_fsm_foe_success(&fsm->fsm_foe)) {
         EC_SLAVE_ERR(slave, "Failed to handle FoE request.\n");
         request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->foe_request = NULL;
         fsm->state = ec_fsm_slave_state_ready;
         return;
     }
 
     // finished transferring FoE
+    duration = (jiffies - request->jiffies_start) * 1000 / HZ;
     EC_SLAVE_DBG(slave, 1, "Successfully transferred %zu bytes of FoE"
-            " data.\n", request->data_size);
+            " data in %u ms (%zu KiB/s).\n", request->data_size, duration,
+            duration ? request->data_size * 1000 / 1024 / duration : 0);
 
     request->state = EC_INT_REQUEST_SUCCESS;
-    wake_up_all(&slave->master->request_queue);
+    ec_fsm_slave_request_done(slave);
     fsm->foe_request = NULL;
     fsm->state = ec_fsm_slave_state_ready;
 }
@@ -1106,7 +1258,7 @@ int ec_fsm_slave_action_process_soe(
         EC_SLAVE_WARN(slave, "Aborting SoE request,"
                 " slave has error flag set.\n");
         req->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
     }
@@ -1114,7 +1266,7 @@ int ec_fsm_slave_action_process_soe(
     if (slave->current_state == EC_SLAVE_STATE_INIT) {
         EC_SLAVE_WARN(slave, "Aborting SoE request, slave is in INIT.\n");
         req->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
     }
@@ -1158,7 +1310,7 @@ int ec_fsm_slave_action_process_mbg(
         EC_SLAVE_WARN(slave, "Aborting MBox Gateway request,"
                 " slave has error flag set.\n");
         req->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
     }
@@ -1167,7 +1319,7 @@ int ec_fsm_slave_action_process_mbg(
         EC_SLAVE_WARN(slave, "Aborting MBox Gateway request,"
                 " slave is in INIT.\n");
         req->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
     }
@@ -1204,7 +1356,7 @@ void ec_fsm_slave_state_mbg_request(
     if (!ec_fsm_mbg_success(&fsm->fsm_mbg)) {
         EC_SLAVE_ERR(slave, "Failed to process MBox Gateway request.\n");
         request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->mbg_request = NULL;
         fsm->state = ec_fsm_slave_state_ready;
         return;
@@ -1214,7 +1366,7 @@ void ec_fsm_slave_state_mbg_request(
 
     // MBox Gateway request finished
     request->state = EC_INT_REQUEST_SUCCESS;
-    wake_up_all(&slave->master->request_queue);
+    ec_fsm_slave_request_done(slave);
     fsm->mbg_request = NULL;
     fsm->state = ec_fsm_slave_state_ready;
 }
@@ -1238,7 +1390,7 @@ void ec_fsm_slave_state_soe_request(
     if (!ec_fsm_soe_success(&fsm->fsm_soe)) {
         EC_SLAVE_ERR(slave, "Failed to process SoE request.\n");
         request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->soe_request = NULL;
         fsm->state = ec_fsm_slave_state_ready;
         return;
@@ -1248,7 +1400,7 @@ void ec_fsm_slave_state_soe_request(
 
     // SoE request finished
     request->state = EC_INT_REQUEST_SUCCESS;
-    wake_up_all(&slave->master->request_queue);
+    ec_fsm_slave_request_done(slave);
     fsm->soe_request = NULL;
     fsm->state = ec_fsm_slave_state_ready;
 }
@@ -1279,7 +1431,7 @@ int ec_fsm_slave_action_process_eoe(
         EC_SLAVE_WARN(slave, "Aborting EoE request,"
                 " slave has error flag set.\n");
         request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
     }
@@ -1287,7 +1439,7 @@ int ec_fsm_slave_action_process_eoe(
     if (slave->current_state == EC_SLAVE_STATE_INIT) {
         EC_SLAVE_WARN(slave, "Aborting EoE request, slave is in INIT.\n");
         request->state = EC_INT_REQUEST_FAILURE;
-        wake_up_all(&slave->master->request_queue);
+        ec_fsm_slave_request_done(slave);
         fsm->state = ec_fsm_slave_state_idle;
         return 0;
     }
@@ -1330,7 +1482,7 @@ void ec_fsm_slave_state_eoe_request(
         EC_SLAVE_ERR(slave, "Failed to process EoE request.\n");
     }
 
-    wake_up_all(&slave->master->request_queue);
+    ec_fsm_slave_request_done(slave);
     fsm->eoe_request = NULL;
     fsm->state = ec_fsm_slave_state_ready;
 }
@@ -68,6 +68,11 @@ struct ec_fsm_slave {
     void (*state)(ec_fsm_slave_t *, ec_datagram_t *); /**< State function. */
     ec_datagram_t *datagram; /**< Previous state datagram. */
     ec_sdo_request_t *sdo_request; /**< SDO request to process. */
+    unsigned int sdo_count; /**< Number of SDO requests processed back to
+                              back. */
+    unsigned long sdo_jiffies_start; /**< Jiffies, when the first of the
+                                       back-to-back SDO requests was
+                                       started. */
     ec_reg_request_t *reg_request; /**< Register request to process. */
     ec_foe_request_t *foe_request; /**< FoE request to process. */
     off_t foe_index; /**< Index to FoE write request data. */
@@ -99,6 +99,13 @@ void ec_fsm_slave_config_enter_assign_pdi(ec_fsm_slave_config_t *, ec_datagram_t
 #endif
 void ec_fsm_slave_config_enter_boot_preop(ec_fsm_slave_config_t *, ec_datagram_t *);
 void ec_fsm_slave_config_enter_sdo_conf(ec_fsm_slave_config_t *, ec_datagram_t *);
+void ec_fsm_slave_config_start_sdo_conf(ec_fsm_slave_config_t *, ec_datagram_t *);
+#ifdef EC_SDO_COALESCING
+int ec_fsm_slave_config_sdo_aligned(const ec_sdo_t *,
+        const ec_sdo_request_t *);
+unsigned int ec_fsm_slave_config_sdo_run(const ec_fsm_slave_config_t *);
+int ec_fsm_slave_config_merge_sdo_conf(ec_fsm_slave_config_t *);
+#endif
 void ec_fsm_slave_config_enter_soe_conf_preop(ec_fsm_slave_config_t *, ec_datagram_t *);
 void ec_fsm_slave_config_enter_pdo_conf(ec_fsm_slave_config_t *, ec_datagram_t *);
 void ec_fsm_slave_config_enter_watchdog_divider(ec_fsm_slave_config_t *, ec_datagram_t *);
@@ -206,10 +213,21 @@ int ec_fsm_slave_config_exec(
     fsm->state(fsm, datagram);
 
     if (!ec_fsm_slave_config_running(fsm)) {
+        ec_slave_t *slave = fsm->slave;
+
+        slave->config_duration =
+            (jiffies - fsm->jiffies_config) * 1000 / HZ;
+        slave->config_round_trips = fsm->round_trips;
+        EC_SLAVE_DBG(slave, 1, "Configuration took %u ms"
+                " with %u datagrams.\n", slave->config_duration,
+                slave->config_round_trips);
         fsm->datagram = NULL;
         return 0;
     }
 
+    if (datagram->state == EC_DATAGRAM_INIT) {
+        fsm->round_trips++;
+    }
     fsm->datagram = datagram;
     return 1;
 }
@@ -238,6 +256,8 @@ void ec_fsm_slave_config_state_start(
         )
 {
     EC_SLAVE_DBG(fsm->slave, 1, "Configuring...\n");
+    fsm->jiffies_config = jiffies;
+    fsm->round_trips = 0;
     ec_fsm_slave_config_enter_init(fsm, datagram);
 }
 
@@ -251,6 +271,8 @@ void ec_fsm_slave_config_state_quick_start(
         )
 {
     EC_SLAVE_DBG(fsm->slave, 1, "Configuring (quick)...\n");
+    fsm->jiffies_config = jiffies;
+    fsm->round_trips = 0;
     ec_fsm_slave_config_enter_soe_conf_safeop(fsm, datagram);
 }
 
@@ -301,6 +323,9 @@ void ec_fsm_slave_config_state_init(
     ec_datagram_fpwr(datagram, slave->station_address,
             0x0600, EC_FMMU_PAGE_SIZE * slave->base_fmmu_count);
     ec_datagram_zero(datagram);
+    slave->mbox_status_mapped = 0;
+    fsm->mbox_status_fmmu =
+        ec_slave_mbox_status_fmmu(slave, 0, datagram->data);
     fsm->retries = EC_FSM_RETRIES;
     fsm->state = ec_fsm_slave_config_state_clear_fmmus;
 
@@ -337,6 +362,7 @@ void ec_fsm_slave_config_state_clear_fmmus(
         return;
     }
 
+    fsm->slave->mbox_status_mapped = fsm->mbox_status_fmmu;
     ec_fsm_slave_config_enter_clear_sync(fsm, datagram);
 }
 
@@ -865,7 +891,27 @@ void ec_fsm_slave_config_enter_sdo_conf(
     fsm->state = ec_fsm_slave_config_state_sdo_conf;
     fsm->request = list_entry(fsm->slave->config->sdo_configs.next,
             ec_sdo_request_t, list);
-    ec_sdo_request_copy(&fsm->request_copy, fsm->request);
+#ifdef EC_SDO_COALESCING
+    fsm->sdo_single = 0;
+#endif
+    ec_fsm_slave_config_start_sdo_conf(fsm, datagram);
+}
+
+/*****************************************************************************/
+
+/** Starts the download of the current SDO configuration.
+ */
+void ec_fsm_slave_config_start_sdo_conf(
+        ec_fsm_slave_config_t *fsm, /**< slave state machine */
+        ec_datagram_t *datagram /**< Datagram to use. */
+        )
+{
+#ifdef EC_SDO_COALESCING
+    if (!ec_fsm_slave_config_merge_sdo_conf(fsm))
+#endif
+    {
+        ec_sdo_request_copy(&fsm->request_copy, fsm->request);
+    }
     ecrt_sdo_request_write(&fsm->request_copy);
     ec_fsm_coe_transfer(fsm->fsm_coe, fsm->slave, &fsm->request_copy);
     ec_fsm_coe_exec(fsm->fsm_coe, datagram); // execute immediately
@@ -873,6 +919,147 @@ void ec_fsm_slave_config_enter_sdo_conf(
 
 /*****************************************************************************/
 
+#ifdef EC_SDO_COALESCING
+
+/** Checks, if an SDO configuration fills its entry in a complete access.
+ *
+ * Complete access packs the entries without padding (except subindex 0), so
+ * only 8, 16 and 32 bit values are merged. The SDO dictionary is usually not
+ * available during configuration; if it is, the entry size has to match,
+ * too. Otherwise, a slave aborts a download that does not match its object
+ * and the configurations are downloaded one by one.
+ *
+ * \return Non-zero, if the configuration can be merged.
+ */
+int ec_fsm_slave_config_sdo_aligned(
+        const ec_sdo_t *sdo, /**< SDO from the dictionary, or NULL. */
+        const ec_sdo_request_t *req /**< SDO configuration. */
+        )
+{
+    const ec_sdo_entry_t *entry;
+
+    if (req->data_size != 1 && req->data_size != 2 && req->data_size != 4) {
+        return 0;
+    }
+
+    if (!sdo || !(entry = ec_sdo_get_entry_const(sdo, req->subindex))) {
+        return 1;
+    }
+
+    return entry->bit_length == req->data_size * 8;
+}
+
+/*****************************************************************************/
+
+/** Counts the SDO configurations, that can be downloaded together with the
+ * current one via complete access.
+ *
+ * These are the following configurations of the same object with
+ * consecutive subindices. Complete access has to start with subindex 0 or 1.
+ *
+ * \return Number of configurations (including the current one).
+ */
+unsigned int ec_fsm_slave_config_sdo_run(
+        const ec_fsm_slave_config_t *fsm /**< slave state machine */
+        )
+{
+    const ec_slave_t *slave = fsm->slave;
+    const ec_sdo_request_t *first = fsm->request, *prev = first, *req;
+    const ec_sdo_t *sdo;
+    unsigned int count = 1;
+
+    if (!slave->sii_image
+            || !slave->sii_image->sii.coe_details.enable_sdo_complete_access
+            || first->complete_access || first->subindex > 1
+            || (!first->subindex && first->data_size != 1)) {
+        return 1;
+    }
+
+    sdo = ec_slave_get_sdo_const(slave, first->index);
+    if (!ec_fsm_slave_config_sdo_aligned(sdo, first)) {
+        return 1;
+    }
+
+    while (prev->list.next != &slave->config->sdo_configs) {
+        req = list_entry(prev->list.next, ec_sdo_request_t, list);
+        if (req->complete_access || req->index != first->index
+                || req->subindex != prev->subindex + 1
+                || !ec_fsm_slave_config_sdo_aligned(sdo, req)) {
+            break;
+        }
+        prev = req;
+        count++;
+    }
+
+    return count;
+}
+
+/*****************************************************************************/
+
+/** Merges the current SDO configuration and the following ones of the same
+ * object into one complete access download.
+ *
+ * \return Non-zero, if \a request_copy contains the merged download.
+ */
+int ec_fsm_slave_config_merge_sdo_conf(
+        ec_fsm_slave_config_t *fsm /**< slave state machine */
+        )
+{
+    const ec_sdo_request_t *req;
+    unsigned int i;
+    size_t size;
+    uint8_t *data;
+
+    if (fsm->sdo_single) { // fallback after a failed complete access
+        fsm->sdo_single--;
+        fsm->sdo_merged = 1;
+        return 0;
+    }
+
+    fsm->sdo_merged = ec_fsm_slave_config_sdo_run(fsm);
+    if (fsm->sdo_merged < 2) {
+        return 0;
+    }
+
+    // subindex 0 is padded to 16 bit in complete access
+    size = fsm->request->subindex ? 0 : 1;
+    req = fsm->request;
+    for (i = 0; i < fsm->sdo_merged; i++) {
+        size += req->data_size;
+        req = list_entry(req->list.next, ec_sdo_request_t, list);
+    }
+
+    if (ec_sdo_request_alloc(&fsm->request_copy, size)) {
+        fsm->sdo_merged = 1;
+        return 0;
+    }
+
+    data = fsm->request_copy.data;
+    req = fsm->request;
+    for (i = 0; i < fsm->sdo_merged; i++) {
+        memcpy(data, req->data, req->data_size);
+        data += req->data_size;
+        if (!req->subindex) {
+            *data++ = 0x00;
+        }
+        req = list_entry(req->list.next, ec_sdo_request_t, list);
+    }
+
+    fsm->request_copy.index = fsm->request->index;
+    fsm->request_copy.subindex = fsm->request->subindex;
+    fsm->request_copy.complete_access = 1;
+    fsm->request_copy.data_size = size;
+
+    EC_SLAVE_DBG(fsm->slave, 1, "Merging %u SDO configurations of 0x%04X"
+            " into one complete access download of %zu bytes.\n",
+            fsm->sdo_merged, fsm->request->index, size);
+    return 1;
+}
+
+#endif
+
+/*****************************************************************************/
+
 /** Slave configuration state: SDO_CONF.
  */
 void ec_fsm_slave_config_state_sdo_conf(
@@ -885,6 +1072,17 @@ void ec_fsm_slave_config_state_sdo_conf(
     }
 
     if (!ec_fsm_coe_success(fsm->fsm_coe)) {
+#ifdef EC_SDO_COALESCING
+        if (fsm->sdo_merged > 1 && fsm->request_copy.abort_code
+                && fsm->slave->config) {
+            EC_SLAVE_WARN(fsm->slave, "Complete access download of SDO"
+                    " 0x%04X aborted. Downloading the %u entries"
+                    " one by one.\n", fsm->request->index, fsm->sdo_merged);
+            fsm->sdo_single = fsm->sdo_merged;
+            ec_fsm_slave_config_start_sdo_conf(fsm, datagram);
+            return;
+        }
+#endif
         EC_SLAVE_ERR(fsm->slave, "SDO configuration failed.\n");
         fsm->slave->error_flag = 1;
         fsm->state = ec_fsm_slave_config_state_error;
@@ -896,14 +1094,19 @@ void ec_fsm_slave_config_state_sdo_conf(
         return;
     }
 
+#ifdef EC_SDO_COALESCING
+    // skip the configurations merged into the last download
+    while (--fsm->sdo_merged) {
+        fsm->request = list_entry(fsm->request->list.next,
+                ec_sdo_request_t, list);
+    }
+#endif
+
     // Another SDO to configure?
     if (fsm->request->list.next != &fsm->slave->config->sdo_configs) {
         fsm->request = list_entry(fsm->request->list.next,
                 ec_sdo_request_t, list);
-        ec_sdo_request_copy(&fsm->request_copy, fsm->request);
-        ecrt_sdo_request_write(&fsm->request_copy);
-        ec_fsm_coe_transfer(fsm->fsm_coe, fsm->slave, &fsm->request_copy);
-        ec_fsm_coe_exec(fsm->fsm_coe, datagram); // execute immediately
+        ec_fsm_slave_config_start_sdo_conf(fsm, datagram);
         return;
     }
 
@@ -1301,7 +1504,9 @@ void ec_fsm_slave_config_enter_fmmu(
     ec_datagram_zero(datagram);
     for (i = 0; i < slave->config->used_fmmus; i++) {
         fmmu = &slave->config->fmmu_configs[i];
-        if (!(sync = ec_slave_get_sync(slave, fmmu->sync_index))) {
+        if (fmmu->sync_index == EC_SYNC_REGISTERS) {
+            sync = NULL;
+        } else if (!(sync = ec_slave_get_sync(slave, fmmu->sync_index))) {
             slave->error_flag = 1;
             fsm->state = ec_fsm_slave_config_state_error;
             EC_SLAVE_ERR(slave, "Failed to determine PDO sync manager"
@@ -1311,6 +1516,9 @@ void ec_fsm_slave_config_enter_fmmu(
         ec_fmmu_config_page(fmmu, sync,
                 datagram->data + EC_FMMU_PAGE_SIZE * i);
     }
+    slave->mbox_status_mapped = 0;
+    fsm->mbox_status_fmmu = ec_slave_mbox_status_fmmu(slave,
+            slave->config->used_fmmus, datagram->data);
 
     fsm->retries = EC_FSM_RETRIES;
     fsm->state = ec_fsm_slave_config_state_fmmu;
@@ -1347,6 +1555,7 @@ void ec_fsm_slave_config_state_fmmu(
         return;
     }
 
+    slave->mbox_status_mapped = fsm->mbox_status_fmmu;
     ec_fsm_slave_config_enter_dc_cycle(fsm, datagram);
 }
 
@@ -1763,6 +1972,17 @@ void ec_fsm_slave_config_enter_op(
         ec_datagram_t *datagram /**< Datagram to use. */
         )
 {
+    ec_slave_t *slave = fsm->slave;
+
+    if (slave->master->group_op && !slave->group_op_failed) {
+        // the master state machine requests OP for all slaves at once
+        EC_SLAVE_DBG(slave, 1, "Waiting for grouped transition to OP.\n");
+        slave->group_op = 1;
+        fsm->state = ec_fsm_slave_config_state_end;
+        return;
+    }
+    slave->group_op_failed = 0;
+
     // set state to OP
     fsm->state = ec_fsm_slave_config_state_op;
     ec_fsm_change_start(fsm->fsm_change, fsm->slave, EC_SLAVE_STATE_OP);
@@ -64,11 +64,22 @@ struct ec_fsm_slave_config
     unsigned int retries; /**< Retries on datagram timeout. */
     ec_sdo_request_t *request; /**< SDO request for SDO configuration. */
     ec_sdo_request_t request_copy; /**< Copied SDO request. */
+#ifdef EC_SDO_COALESCING
+    unsigned int sdo_merged; /**< Number of SDO configurations merged into
+                               \a request_copy. */
+    unsigned int sdo_single; /**< Number of SDO configurations to download
+                               one by one after a failed complete access
+                               download. */
+#endif
     ec_soe_request_t *soe_request; /**< SDO request for SDO configuration. */
     ec_soe_request_t soe_request_copy; /**< Copied SDO request. */
     unsigned long last_diff_ms; /**< For sync reporting. */
     unsigned long jiffies_start; /**< For timeout calculations. */
     unsigned int take_time; /**< Store jiffies after datagram reception. */
+    unsigned int mbox_status_fmmu; /**< The FMMU datagram maps the mailbox
+                                     status. */
+    unsigned long jiffies_config; /**< Start of the configuration. */
+    unsigned int round_trips; /**< Datagrams sent for the configuration. */
 };
 
 /*****************************************************************************/
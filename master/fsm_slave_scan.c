@@ -65,6 +65,7 @@ void ec_fsm_slave_scan_state_assign_sii(ec_fsm_slave_scan_t *, ec_datagram_t *);
 #endif
 #ifdef EC_SII_CACHE
 void ec_fsm_slave_scan_state_sii_identity(ec_fsm_slave_scan_t *, ec_datagram_t *);
+void ec_fsm_slave_scan_state_sii_verify(ec_fsm_slave_scan_t *, ec_datagram_t *);
 #endif
 #ifdef EC_SII_OVERRIDE
 void ec_fsm_slave_scan_state_sii_device(ec_fsm_slave_scan_t *, ec_datagram_t *);
@@ -92,6 +93,7 @@ void ec_fsm_slave_scan_enter_regalias(ec_fsm_slave_scan_t *, ec_datagram_t *);
 #endif
 #ifdef EC_SII_CACHE
 void ec_fsm_slave_scan_enter_sii_identity(ec_fsm_slave_scan_t *, ec_datagram_t *);
+void ec_fsm_slave_scan_enter_sii_verify(ec_fsm_slave_scan_t *, ec_datagram_t *);
 #endif
 #ifdef EC_SII_OVERRIDE
 void ec_fsm_slave_scan_enter_sii_request(ec_fsm_slave_scan_t *, ec_datagram_t *);
@@ -205,7 +207,9 @@ int ec_fsm_slave_scan_success(const ec_fsm_slave_scan_t *fsm /**< slave state ma
 /**
    Slave scan state: START.
    First state of the slave state machine. Writes the station address to the
-   slave, according to its ring position.
+   slave, according to its ring position. Slaves, that were kept during an
+   incremental bus scan, only refresh their port receive times and their DL
+   status.
 */
 
 void ec_fsm_slave_scan_state_start(
@@ -213,6 +217,26 @@ void ec_fsm_slave_scan_state_start(
         ec_datagram_t *datagram /**< Datagram to use. */
         )
 {
+    ec_slave_t *slave = fsm->slave;
+    int i;
+
+    if (slave->scan_ports_only) {
+        for (i = 0; i < EC_MAX_PORTS; i++) {
+            slave->ports[i].link.bypassed = 0;
+        }
+
+        if (slave->base_dc_supported) {
+            // read DC port receive times
+            ec_datagram_fprd(datagram, slave->station_address, 0x0900, 16);
+            ec_datagram_zero(datagram);
+            fsm->retries = EC_FSM_RETRIES;
+            fsm->state = ec_fsm_slave_scan_state_dc_times;
+        } else {
+            ec_fsm_slave_scan_enter_datalink(fsm, datagram);
+        }
+        return;
+    }
+
     // write station address
     ec_datagram_apwr(datagram, fsm->slave->ring_position, 0x0010, 2);
     EC_WRITE_U16(datagram->data, fsm->slave->station_address);
@@ -514,6 +538,23 @@ void ec_fsm_slave_scan_enter_sii_identity(
     fsm->state = ec_fsm_slave_scan_state_sii_identity;
     fsm->state(fsm, datagram); // execute state immediately
 }
+
+/*****************************************************************************/
+
+/** Enter slave scan state SII_VERIFY.
+ */
+void ec_fsm_slave_scan_enter_sii_verify(
+        ec_fsm_slave_scan_t *fsm, /**< slave state machine */
+        ec_datagram_t *datagram /**< Datagram to use. */
+        )
+{
+    // Fetch the SII checksum and identity to validate the cached image
+    fsm->sii_offset = EC_CHECKSUM_SII_OFFSET;
+    ec_fsm_sii_read(&fsm->fsm_sii, fsm->slave, fsm->sii_offset,
+            EC_FSM_SII_USE_CONFIGURED_ADDRESS);
+    fsm->state = ec_fsm_slave_scan_state_sii_verify;
+    fsm->state(fsm, datagram); // execute state immediately
+}
 #endif
 
 /*****************************************************************************/
@@ -575,6 +616,12 @@ void ec_fsm_slave_scan_enter_attach_sii(
         for (i = 0; i < slave->sii_image->sii.sync_count; i++) {
             slave->sii_image->sii.syncs[i].slave = slave;
         }
+        if (sii_image->loaded) {
+            // The SII image was loaded from the persistent cache and has to
+            // be validated and parsed first
+            ec_fsm_slave_scan_enter_sii_verify(fsm, datagram);
+            return;
+        }
         // The SII image data is already available and we can enter PREOP
 #ifdef EC_REGALIAS
         ec_fsm_slave_scan_enter_regalias(fsm, datagram);
@@ -706,6 +753,11 @@ void ec_fsm_slave_scan_state_datalink(
 
     ec_slave_set_dl_status(slave, EC_READ_U16(fsm->datagram->data));
 
+    if (slave->scan_ports_only) {
+        fsm->state = ec_fsm_slave_scan_state_end;
+        return;
+    }
+
 #ifdef EC_SII_ASSIGN
     ec_fsm_slave_scan_enter_assign_sii(fsm, datagram);
 #elif defined(EC_SII_CACHE)
@@ -838,6 +890,82 @@ void ec_fsm_slave_scan_state_sii_identity(
                 EC_FSM_SII_USE_CONFIGURED_ADDRESS);
     }
 }
+
+/*****************************************************************************/
+
+/**
+   Slave scan state: SII VERIFY.
+
+   Compares the SII checksum, vendor ID, product code and serial number of
+   the slave with a cached SII image loaded from the persistent cache.
+*/
+
+void ec_fsm_slave_scan_state_sii_verify(
+        ec_fsm_slave_scan_t *fsm, /**< slave state machine */
+        ec_datagram_t *datagram /**< Datagram to use. */
+        )
+{
+    ec_slave_t *slave = fsm->slave;
+    ec_sii_image_t *sii_image = slave->sii_image;
+    const uint16_t *words;
+    int match;
+
+    while (1) {
+        if (ec_fsm_sii_exec(&fsm->fsm_sii, datagram))
+            return;
+
+        if (!ec_fsm_sii_success(&fsm->fsm_sii)) {
+            EC_SLAVE_ERR(slave, "Failed to verify cached SII image.\n");
+            if (fsm->scan_retries--) {
+                fsm->state = ec_fsm_slave_scan_state_retry;
+            } else {
+                fsm->slave->error_flag = 1;
+                fsm->state = ec_fsm_slave_scan_state_error;
+            }
+            return;
+        }
+
+        words = sii_image->words + fsm->sii_offset;
+        if (fsm->sii_offset == EC_CHECKSUM_SII_OFFSET) {
+            match = EC_READ_U16(fsm->fsm_sii.value) == EC_READ_U16(words);
+        } else {
+            match = EC_READ_U32(fsm->fsm_sii.value) == EC_READ_U32(words);
+        }
+
+        if (!match) {
+            EC_SLAVE_WARN(slave, "Cached SII image does not match the"
+                    " slave's SII at word 0x%04x. Re-reading SII.\n",
+                    fsm->sii_offset);
+            // Re-use the image for the data read from the slave
+            ec_sii_image_clear(sii_image);
+            ec_slave_sii_image_init(sii_image);
+            ec_fsm_slave_scan_enter_sii_size(fsm, datagram);
+            return;
+        }
+
+        switch (fsm->sii_offset) {
+            case EC_CHECKSUM_SII_OFFSET:
+                fsm->sii_offset = EC_VENDOR_SII_OFFSET;
+                break;
+            case EC_VENDOR_SII_OFFSET:
+                fsm->sii_offset = EC_PRODUCT_SII_OFFSET;
+                break;
+            case EC_PRODUCT_SII_OFFSET:
+                fsm->sii_offset = EC_SERIAL_SII_OFFSET;
+                break;
+            default:
+                EC_SLAVE_DBG(slave, 1,
+                        "Using SII image from persistent cache.\n");
+                sii_image->loaded = 0;
+                fsm->state = ec_fsm_slave_scan_state_sii_parse;
+                fsm->state(fsm, datagram); // execute state immediately
+                return;
+        }
+
+        ec_fsm_sii_read(&fsm->fsm_sii, fsm->slave, fsm->sii_offset,
+                EC_FSM_SII_USE_CONFIGURED_ADDRESS);
+    }
+}
 #endif
 
 #ifdef EC_SII_OVERRIDE
@@ -853,6 +981,7 @@ void ec_fsm_slave_scan_state_sii_device(
         )
 {
     ec_slave_t *slave = fsm->slave;
+    unsigned int nwords;
 
     if (ec_fsm_sii_exec(&fsm->fsm_sii, datagram))
         return;
@@ -870,11 +999,14 @@ void ec_fsm_slave_scan_state_sii_device(
         return;
     }
 
-    memcpy(slave->vendor_words + fsm->sii_offset, fsm->fsm_sii.value, 4);
+    nwords = min_t(unsigned int, fsm->fsm_sii.value_size / 2,
+            16 - fsm->sii_offset);
+    memcpy(slave->vendor_words + fsm->sii_offset, fsm->fsm_sii.value,
+            nwords * 2);
 
-    if (fsm->sii_offset + 2 < 16) {
-        // fetch the next 2 words
-        fsm->sii_offset += 2;
+    if (fsm->sii_offset + nwords < 16) {
+        // fetch the next words
+        fsm->sii_offset += nwords;
         ec_fsm_sii_read(&fsm->fsm_sii, slave, fsm->sii_offset,
                         EC_FSM_SII_USE_CONFIGURED_ADDRESS);
         ec_fsm_sii_exec(&fsm->fsm_sii, datagram); // execute state immediately
@@ -1123,6 +1255,8 @@ alloc_sii:
     // Start fetching SII contents
     fsm->sii_offset = 0x0000;
 #endif
+    fsm->sii_reads = 1;
+    fsm->sii_jiffies_start = jiffies;
     fsm->state = ec_fsm_slave_scan_state_sii_data;
     ec_fsm_sii_read(&fsm->fsm_sii, slave, fsm->sii_offset,
             EC_FSM_SII_USE_CONFIGURED_ADDRESS);
@@ -1141,6 +1275,7 @@ void ec_fsm_slave_scan_state_sii_data(
         )
 {
     ec_slave_t *slave = fsm->slave;
+    size_t nwords;
 
     if (ec_fsm_sii_exec(&fsm->fsm_sii, datagram)) return;
 
@@ -1162,23 +1297,27 @@ void ec_fsm_slave_scan_state_sii_data(
         return;
     }
 
-    // 2 words fetched
+    // 2 or 4 words fetched, depending on the slave's EEPROM read size
 
-    if (fsm->sii_offset + 2 <= slave->sii_image->nwords) { // 2 words fit
-        memcpy(slave->sii_image->words + fsm->sii_offset, fsm->fsm_sii.value, 4);
-    } else { // copy the last word
-        memcpy(slave->sii_image->words + fsm->sii_offset, fsm->fsm_sii.value, 2);
-    }
+    nwords = min_t(size_t, fsm->fsm_sii.value_size / 2,
+            slave->sii_image->nwords - fsm->sii_offset);
+    memcpy(slave->sii_image->words + fsm->sii_offset, fsm->fsm_sii.value,
+            nwords * 2);
 
-    if (fsm->sii_offset + 2 < slave->sii_image->nwords) {
-        // fetch the next 2 words
-        fsm->sii_offset += 2;
+    if (fsm->sii_offset + nwords < slave->sii_image->nwords) {
+        // fetch the next words
+        fsm->sii_offset += nwords;
+        fsm->sii_reads++;
         ec_fsm_sii_read(&fsm->fsm_sii, slave, fsm->sii_offset,
                         EC_FSM_SII_USE_CONFIGURED_ADDRESS);
         ec_fsm_sii_exec(&fsm->fsm_sii, datagram); // execute state immediately
         return;
     }
 
+    EC_SLAVE_DBG(slave, 1, "Read %zu SII words with %u read commands"
+            " in %u ms.\n", slave->sii_image->nwords, fsm->sii_reads,
+            jiffies_to_msecs(jiffies - fsm->sii_jiffies_start));
+
     fsm->state = ec_fsm_slave_scan_state_sii_parse;
     fsm->state(fsm, datagram); // execute state immediately
 }
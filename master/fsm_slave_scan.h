@@ -65,6 +65,9 @@ struct ec_fsm_slave_scan
 
     void (*state)(ec_fsm_slave_scan_t *, ec_datagram_t *); /**< State function. */
     uint16_t sii_offset; /**< SII offset in words. */
+    unsigned int sii_reads; /**< SII read commands for the SII contents. */
+    unsigned long sii_jiffies_start; /**< Start of reading the SII
+                                       contents. */
 
     ec_fsm_sii_t fsm_sii; /**< SII state machine. */
 
@@ -70,6 +70,16 @@
 /** Number of statistic rate intervals to maintain. */
 #define EC_RATE_COUNT 3
 
+/** Number of logarithmic bins of a datagram latency histogram.
+ *
+ * Bin \a i counts round-trip times from 2^i to 2^(i+1) - 1 ns, the last bin
+ * also counts all longer times.
+ */
+#define EC_LATENCY_BIN_COUNT 32
+
+/** Number of master event types (bits of \a EC_EVENT_ALL). */
+#define EC_EVENT_COUNT 4
+
 /******************************************************************************
  * EtherCAT protocol
  *****************************************************************************/
@@ -86,6 +96,9 @@
 /** Size of the EtherCAT address field. */
 #define EC_ADDR_LEN 4
 
+/** Number of distinct datagram indices (the index field is 8 bit wide). */
+#define EC_DATAGRAM_INDEX_COUNT 256
+
 /** Resulting maximum data size of a single datagram in a frame. */
 #ifdef DEBUG_DATAGRAM_OVERFLOW
 // Define a runt datagram which can be easily overflowed on 
@@ -111,6 +124,9 @@
 /** Word offset of SII alias. */
 #define EC_ALIAS_SII_OFFSET 0x04
 
+/** Word offset of SII checksum. */
+#define EC_CHECKSUM_SII_OFFSET 0x07
+
 /** Word offset of SII vendor ID. */
 #define EC_VENDOR_SII_OFFSET 0x08
 
@@ -132,6 +148,13 @@
 /** Size of an FMMU configuration page. */
 #define EC_FMMU_PAGE_SIZE 16
 
+/** Sync manager index of FMMUs mapping ESC registers instead of sync manager
+ * memory. */
+#define EC_SYNC_REGISTERS 0xff
+
+/** Size of the ESC register address space. */
+#define EC_ESC_REGISTER_SIZE 0x1000
+
 /** Number of DC sync signals. */
 #define EC_SYNC_SIGNAL_COUNT 2
 
@@ -240,6 +263,18 @@ typedef enum {
 
 extern const char *ec_device_names[2]; // only main and backup!
 
+/** Datagram classes for latency statistics.
+ */
+typedef enum {
+    EC_DATAGRAM_CLASS_OTHER, /**< Any other datagram. */
+    EC_DATAGRAM_CLASS_DOMAIN, /**< Cyclic process data. */
+    EC_DATAGRAM_CLASS_DC, /**< Distributed clocks synchronisation. */
+    EC_DATAGRAM_CLASS_FSM, /**< Master state machine. */
+    EC_DATAGRAM_CLASS_SLAVE_FSM, /**< Slave state machines. */
+    EC_DATAGRAM_CLASS_EOE, /**< Ethernet over EtherCAT. */
+    EC_DATAGRAM_CLASS_COUNT /**< Number of datagram classes. */
+} ec_datagram_class_t;
+
 /*****************************************************************************/
 
 /** Convenience macro for printing EtherCAT-specific information to syslog.
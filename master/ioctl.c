@@ -132,6 +132,11 @@ static ATTRIBUTES int ec_ioctl_master(
     io.phase = (uint8_t) master->phase;
     io.active = (uint8_t) master->active;
     io.scan_busy = master->scan_busy;
+    io.scan_incremental = master->scan_incremental;
+    io.scan_duration = master->scan_duration;
+    io.op_pending = master->op_pending;
+    io.op_grouped = master->op_grouped;
+    io.op_duration = master->op_duration;
 
     ec_lock_up(&master->master_sem);
 
@@ -186,6 +191,14 @@ static ATTRIBUTES int ec_ioctl_master(
         io.loss_rates[j] =
             master->device_stats.loss_rates[j];
     }
+    io.cycle_count = master->device_stats.cycle_count;
+    io.cycle_frames = master->device_stats.cycle_frames;
+    io.cycle_frame_bytes = master->device_stats.cycle_frame_bytes;
+    io.last_cycle_frames = master->device_stats.last_cycle_frames;
+    io.timeouts = master->stats.total_timeouts;
+    io.last_cycle_timeouts = master->stats.last_cycle_timeouts;
+    io.mbox_status_reads = master->mbox_status_reads;
+    io.mbox_status_checks = master->mbox_status_checks;
 
     ec_lock_up(&master->device_sem);
 
@@ -321,6 +334,8 @@ static ATTRIBUTES int ec_ioctl_slave(
     data.scan_required = slave->scan_required;
     data.sdo_count = ec_slave_sdo_count(slave);
     data.ready = ec_fsm_slave_is_ready(&slave->fsm);
+    data.config_duration = slave->config_duration;
+    data.config_round_trips = slave->config_round_trips;
 
     ec_lock_up(&master->master_sem);
 
@@ -577,6 +592,7 @@ static ATTRIBUTES int ec_ioctl_domain(
     }
     data.expected_working_counter = domain->expected_working_counter;
     data.fmmu_count = ec_domain_fmmu_count(domain);
+    data.copied_bytes = domain->copied_bytes;
 
     ec_lock_up(&master->master_sem);
 
@@ -788,6 +804,120 @@ static ATTRIBUTES int ec_ioctl_master_rescan(
 
 /*****************************************************************************/
 
+/** Get datagram latency statistics.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_master_latency(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg /**< Userspace address to store the results. */
+        )
+{
+    ec_ioctl_master_latency_t data;
+    const ec_latency_stats_t *stats;
+
+    if (copy_from_user(&data, (void __user *) arg, sizeof(data))) {
+        return -EFAULT;
+    }
+
+    if (data.device_index >= ec_master_num_devices(master)
+            || data.datagram_class >= EC_DATAGRAM_CLASS_COUNT) {
+        return -EINVAL;
+    }
+
+    stats = &master->latency_stats[data.device_index][data.datagram_class];
+    data.count = stats->count;
+    data.sum_ns = stats->sum_ns;
+    data.min_ns = stats->min_ns;
+    data.max_ns = stats->max_ns;
+    memcpy(data.bins, stats->bins, sizeof(data.bins));
+
+    if (copy_to_user((void __user *) arg, &data, sizeof(data))) {
+        return -EFAULT;
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+
+/** Reset datagram latency statistics.
+ *
+ * \return Always zero (success).
+ */
+static ATTRIBUTES int ec_ioctl_master_latency_reset(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg /**< ioctl() argument. */
+        )
+{
+    ec_master_clear_latency_stats(master);
+    return 0;
+}
+
+/*****************************************************************************/
+
+#ifndef EC_IOCTL_RTDM
+
+/** Get and acknowledge pending master events.
+ *
+ * If \a select is set, the events reported via poll() are selected
+ * beforehand.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_events(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg, /**< ioctl() argument. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_ioctl_events_t data;
+
+    if (copy_from_user(&data, (void __user *) arg, sizeof(data))) {
+        return -EFAULT;
+    }
+
+    if (data.select) {
+        ctx->events = data.events & EC_EVENT_ALL;
+    }
+
+    data.events = ctx->events;
+    data.pending = ec_master_fetch_events(master, ctx->event_acks,
+            ctx->events);
+
+    if (copy_to_user((void __user *) arg, &data, sizeof(data))) {
+        return -EFAULT;
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+
+/** Bind an eventfd to master events (a negative descriptor unbinds).
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_eventfd(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg, /**< ioctl() argument. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_ioctl_eventfd_t data;
+
+    if (copy_from_user(&data, (void __user *) arg, sizeof(data))) {
+        return -EFAULT;
+    }
+
+    return ec_master_bind_eventfd(master, &ctx->event_binding, data.fd,
+            data.events & EC_EVENT_ALL);
+}
+
+#endif
+
+/*****************************************************************************/
+
 /** Set slave state.
  *
  * \return Zero on success, otherwise a negative error code.
@@ -1233,6 +1363,109 @@ static ATTRIBUTES int ec_ioctl_slave_sii_write(
 
 /*****************************************************************************/
 
+#ifdef EC_SII_CACHE
+
+/** Read an SII image from the SII cache.
+ *
+ * The image size is always returned. The words are only copied, if the
+ * given buffer is large enough.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_sii_cache_read(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg /**< ioctl() argument. */
+        )
+{
+    ec_ioctl_sii_cache_t data;
+    const ec_sii_image_t *sii_image;
+    int retval = 0;
+
+    if (copy_from_user(&data, (void __user *) arg, sizeof(data))) {
+        return -EFAULT;
+    }
+
+    if (ec_lock_down_interruptible(&master->master_sem))
+        return -EINTR;
+
+    data.count = ec_master_sii_cache_count(master);
+
+    if (!(sii_image = ec_master_get_cached_sii_image(master, data.index))) {
+        ec_lock_up(&master->master_sem);
+        data.nwords = 0;
+        goto out;
+    }
+
+    if (data.nwords >= sii_image->nwords && copy_to_user(
+                (void __user *) data.words, sii_image->words,
+                sii_image->nwords * 2)) {
+        retval = -EFAULT;
+    }
+    data.nwords = sii_image->nwords;
+
+    ec_lock_up(&master->master_sem);
+
+out:
+    if (!retval && copy_to_user((void __user *) arg, &data, sizeof(data)))
+        retval = -EFAULT;
+
+    return retval;
+}
+
+/*****************************************************************************/
+
+/** Load an SII image into the SII cache.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_sii_cache_load(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg /**< ioctl() argument. */
+        )
+{
+    ec_ioctl_sii_cache_t data;
+    unsigned int byte_size;
+    uint16_t *words;
+    int retval;
+
+    if (copy_from_user(&data, (void __user *) arg, sizeof(data))) {
+        return -EFAULT;
+    }
+
+    if (!data.nwords || data.nwords > EC_MAX_SII_SIZE) {
+        return -EINVAL;
+    }
+
+    byte_size = sizeof(uint16_t) * data.nwords;
+    if (!(words = kmalloc(byte_size, GFP_KERNEL))) {
+        EC_MASTER_ERR(master, "Failed to allocate %u bytes"
+                " for SII contents.\n", byte_size);
+        return -ENOMEM;
+    }
+
+    if (copy_from_user(words,
+                (void __user *) data.words, byte_size)) {
+        kfree(words);
+        return -EFAULT;
+    }
+
+    if (ec_lock_down_interruptible(&master->master_sem)) {
+        kfree(words);
+        return -EINTR;
+    }
+
+    retval = ec_master_add_cached_sii_image(master, words, data.nwords);
+
+    ec_lock_up(&master->master_sem);
+
+    kfree(words);
+    return retval;
+}
+
+#endif
+
+/*****************************************************************************/
+
 /** Read a slave's registers.
  *
  * \return Zero on success, otherwise a negative error code.
@@ -2214,6 +2447,8 @@ static ATTRIBUTES int ec_ioctl_setup_domain_memory(
         io.process_data_size = 0;
     }
 
+    io.status_size = 0;
+    io.ring_size = 0;
 
     if (copy_to_user((void __user *) arg, &io,
                 sizeof(ec_ioctl_master_activate_t)))
@@ -2301,11 +2536,35 @@ static ATTRIBUTES int ec_ioctl_activate(
 #ifndef EC_IOCTL_RTDM
     ecrt_master_callbacks(master, ec_master_internal_send_cb,
             ec_master_internal_receive_cb, master);
+
+    /* Set up the request ring before the operation thread starts to
+     * consume it. */
+    if (!master->active) {
+        if (ec_lock_down_interruptible(&master->master_sem))
+            return -EINTR;
+        ret = ec_request_ring_alloc(&master->request_ring);
+        ec_lock_up(&master->master_sem);
+        if (ret < 0)
+            return ret;
+    }
 #endif
 
     ret = ecrt_master_activate(master);
-    if (ret < 0)
+    if (ret < 0) {
+#ifndef EC_IOCTL_RTDM
+        ec_request_ring_free(&master->request_ring);
+#endif
         return ret;
+    }
+
+#ifdef EC_IOCTL_RTDM
+    /* The status page and the request ring can not be mapped via RTDM. */
+    io.status_size = 0;
+    io.ring_size = 0;
+#else
+    io.status_size = master->status_size;
+    io.ring_size = master->request_ring.mem_size;
+#endif
 
     if (copy_to_user((void __user *) arg, &io,
                 sizeof(ec_ioctl_master_activate_t)))
@@ -2386,6 +2645,73 @@ static ATTRIBUTES int ec_ioctl_set_send_interval(
 
 /*****************************************************************************/
 
+/** Sends frames on behalf of the application.
+ *
+ * Sending is likely to be used by more than one application task, but it
+ * must not wait for the master thread executing the state machines (under
+ * master_sem), so it is serialized via io_sem only. The internal send
+ * callback takes io_sem itself.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static int ec_ioctl_exec_send(
+        ec_master_t *master, /**< EtherCAT master. */
+        size_t *sent_bytes /**< Number of bytes sent. */
+        )
+{
+#if defined(EC_RTDM) && defined(EC_EOE)
+    if (ec_ioctl_lock_down_interruptible(&master->io_sem))
+        return -EINTR;
+    *sent_bytes = ecrt_master_send(master);
+    ec_ioctl_lock_up(&master->io_sem);
+#else
+    if (master->send_cb != NULL) {
+        master->send_cb(master->cb_data);
+        *sent_bytes = 0;
+    } else {
+        if (ec_ioctl_lock_down_interruptible(&master->io_sem))
+            return -EINTR;
+        *sent_bytes = ecrt_master_send(master);
+        ec_ioctl_lock_up(&master->io_sem);
+    }
+#endif
+
+    return 0;
+}
+
+/*****************************************************************************/
+
+/** Receives frames on behalf of the application.
+ *
+ * Serialized via io_sem, see ec_ioctl_exec_send().
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static int ec_ioctl_exec_receive(
+        ec_master_t *master /**< EtherCAT master. */
+        )
+{
+#if defined(EC_RTDM) && defined(EC_EOE)
+    if (ec_ioctl_lock_down_interruptible(&master->io_sem))
+        return -EINTR;
+    ecrt_master_receive(master);
+    ec_ioctl_lock_up(&master->io_sem);
+#else
+    if (master->receive_cb != NULL) {
+        master->receive_cb(master->cb_data);
+    } else {
+        if (ec_ioctl_lock_down_interruptible(&master->io_sem))
+            return -EINTR;
+        ecrt_master_receive(master);
+        ec_ioctl_lock_up(&master->io_sem);
+    }
+#endif
+
+    return 0;
+}
+
+/*****************************************************************************/
+
 /** Send frames.
  *
  * \return Zero on success, otherwise a negative error code.
@@ -2397,27 +2723,16 @@ static ATTRIBUTES int ec_ioctl_send(
         )
 {
     size_t sent_bytes;
+    int ret;
 
     if (unlikely(!ctx->requested)) {
         return -EPERM;
     }
 
-    /* Locking added as send is likely to be used by more than
-        one application tasks */
-    if (ec_ioctl_lock_down_interruptible(&master->master_sem))
-        return -EINTR;
-
-#if defined(EC_RTDM) && defined(EC_EOE)
-    sent_bytes = ecrt_master_send(master);
-#else
-    if (master->send_cb != NULL) {
-        master->send_cb(master->cb_data);
-        sent_bytes = 0;
-    } else
-        sent_bytes = ecrt_master_send(master);
-#endif
-
-    ec_ioctl_lock_up(&master->master_sem);
+    ret = ec_ioctl_exec_send(master, &sent_bytes);
+    if (ret) {
+        return ret;
+    }
 
     if (copy_to_user((void __user *) arg, &sent_bytes, sizeof(sent_bytes))) {
         return -EFAULT;
@@ -2442,23 +2757,7 @@ static ATTRIBUTES int ec_ioctl_receive(
         return -EPERM;
     }
 
-    /* Locking added as receive is likely to be used by more than
-       one application tasks */
-    if (ec_ioctl_lock_down_interruptible(&master->master_sem))
-        return -EINTR;
-
-#if defined(EC_RTDM) && defined(EC_EOE)
-    ecrt_master_receive(master);
-#else
-    if (master->receive_cb != NULL)
-        master->receive_cb(master->cb_data);
-    else
-        ecrt_master_receive(master);
-#endif
-
-    ec_ioctl_lock_up(&master->master_sem);
-
-    return 0;
+    return ec_ioctl_exec_receive(master);
 }
 
 /*****************************************************************************/
@@ -3214,26 +3513,70 @@ static ATTRIBUTES int ec_ioctl_sc_reg_pdo_pos(
 
 /*****************************************************************************/
 
-/** Sets the DC AssignActivate word and the sync signal times.
+/** Registers a range of ESC registers in a domain.
  *
- * \return Zero on success, otherwise a negative error code.
+ * \return Process data offset on success, otherwise a negative error code.
  */
-static ATTRIBUTES int ec_ioctl_sc_dc(
+static ATTRIBUTES int ec_ioctl_sc_reg_esc(
         ec_master_t *master, /**< EtherCAT master. */
         void *arg, /**< ioctl() argument. */
         ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
         )
 {
-    ec_ioctl_config_t data;
+    ec_ioctl_reg_esc_t io;
     ec_slave_config_t *sc;
+    ec_domain_t *domain;
 
-    if (unlikely(!ctx->requested))
+    if (unlikely(!ctx->requested)) {
         return -EPERM;
+    }
 
-    if (copy_from_user(&data, (void __user *) arg, sizeof(data)))
+    if (copy_from_user(&io, (void __user *) arg, sizeof(io))) {
         return -EFAULT;
+    }
 
-    if (ec_lock_down_interruptible(&master->master_sem))
+    if (ec_lock_down_interruptible(&master->master_sem)) {
+        return -EINTR;
+    }
+
+    if (!(sc = ec_master_get_config(master, io.config_index))) {
+        ec_lock_up(&master->master_sem);
+        return -ENOENT;
+    }
+
+    if (!(domain = ec_master_find_domain(master, io.domain_index))) {
+        ec_lock_up(&master->master_sem);
+        return -ENOENT;
+    }
+
+    ec_lock_up(&master->master_sem); /** \todo sc or domain could be invalidated */
+
+    return ecrt_slave_config_reg_esc_registers(sc, io.address, io.size,
+            domain);
+}
+
+/*****************************************************************************/
+
+/** Sets the DC AssignActivate word and the sync signal times.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_sc_dc(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg, /**< ioctl() argument. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_ioctl_config_t data;
+    ec_slave_config_t *sc;
+
+    if (unlikely(!ctx->requested))
+        return -EPERM;
+
+    if (copy_from_user(&data, (void __user *) arg, sizeof(data)))
+        return -EFAULT;
+
+    if (ec_lock_down_interruptible(&master->master_sem))
         return -EINTR;
 
     if (!(sc = ec_master_get_config(master, data.config_index))) {
@@ -3853,19 +4196,20 @@ static ATTRIBUTES int ec_ioctl_domain_process(
     if (unlikely(!ctx->requested))
         return -EPERM;
 
-    /* Locking added as domain processing is likely to be used by more than
-       one application tasks */
-    if (ec_ioctl_lock_down_interruptible(&master->master_sem)) {
-        return -EINTR;
-    }
-
+    /* Domain processing is likely to be used by more than one application
+       task. It is serialized with sending and receiving via io_sem, see
+       ec_ioctl_exec_send(). No master_sem needed, because the domain will
+       not be deleted in the meantime. */
     if (!(domain = ec_master_find_domain(master, (unsigned long) arg))) {
-        ec_ioctl_lock_up(&master->master_sem);
         return -ENOENT;
     }
 
+    if (ec_ioctl_lock_down_interruptible(&master->io_sem)) {
+        return -EINTR;
+    }
+
     ecrt_domain_process(domain);
-    ec_ioctl_lock_up(&master->master_sem);
+    ec_ioctl_lock_up(&master->io_sem);
     return 0;
 }
 
@@ -3886,21 +4230,137 @@ static ATTRIBUTES int ec_ioctl_domain_queue(
     if (unlikely(!ctx->requested))
         return -EPERM;
 
-    /* Locking added as domain queing is likely to be used by more than
-       one application tasks */
-    if (ec_ioctl_lock_down_interruptible(&master->master_sem))
-        return -EINTR;
-
+    /* Serialized via io_sem, see ec_ioctl_domain_process(). */
     if (!(domain = ec_master_find_domain(master, (unsigned long) arg))) {
-        ec_ioctl_lock_up(&master->master_sem);
         return -ENOENT;
     }
 
+    if (ec_ioctl_lock_down_interruptible(&master->io_sem))
+        return -EINTR;
+
     ecrt_domain_queue(domain);
 
-    ec_ioctl_lock_up(&master->master_sem);
+    ec_ioctl_lock_up(&master->io_sem);
+
+    return 0;
+}
+
+/*****************************************************************************/
+
+/** Executes several cyclic operations at once.
+ *
+ * See ecrt_master_cycle(). The domain and distributed clocks operations are
+ * serialized via io_sem, see ec_ioctl_exec_send().
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_cycle(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg, /**< ioctl() argument. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_ioctl_cycle_t data;
+    ec_ioctl_cycle_domain_t __user *entries;
+    ec_domain_t *domain;
+    ec_domain_state_t state;
+    uint32_t i, domain_index;
+    size_t sent_bytes = 0;
+    int ret = 0;
+
+    if (unlikely(!ctx->requested))
+        return -EPERM;
+
+    if (copy_from_user(&data, (void __user *) arg, sizeof(data))) {
+        return -EFAULT;
+    }
+
+    if (data.operations & ~EC_IOCTL_CYCLE_OPERATIONS) {
+        return -EINVAL;
+    }
+
+    entries = (ec_ioctl_cycle_domain_t __user *) data.domains;
+
+    if (data.operations & EC_CYCLE_RECEIVE) {
+        ret = ec_ioctl_exec_receive(master);
+        if (ret) {
+            return ret;
+        }
+    }
+
+    if (data.operations & ~(EC_CYCLE_RECEIVE | EC_CYCLE_SEND)) {
+        if (ec_ioctl_lock_down_interruptible(&master->io_sem))
+            return -EINTR;
+
+        if (data.operations & EC_CYCLE_PROCESS) {
+            for (i = 0; i < data.domain_count; i++) {
+                if (get_user(domain_index, &entries[i].domain_index)) {
+                    ret = -EFAULT;
+                    goto out_unlock;
+                }
+                if (!(domain = ec_master_find_domain(master, domain_index))) {
+                    ret = -ENOENT;
+                    goto out_unlock;
+                }
+                ecrt_domain_process(domain);
+                ecrt_domain_state(domain, &state);
+                if (copy_to_user(&entries[i].state, &state, sizeof(state))) {
+                    ret = -EFAULT;
+                    goto out_unlock;
+                }
+            }
+        }
+
+        if (data.operations & EC_CYCLE_APP_TIME) {
+            ecrt_master_application_time(master, data.app_time);
+        }
+        if (data.operations & EC_CYCLE_SYNC_REF) {
+            ecrt_master_sync_reference_clock(master);
+        }
+        if (data.operations & EC_CYCLE_SYNC_REF_TO) {
+            ecrt_master_sync_reference_clock_to(master, data.sync_time);
+        }
+        if (data.operations & EC_CYCLE_SYNC_SLAVES) {
+            ecrt_master_sync_slave_clocks(master);
+        }
+        if (data.operations & EC_CYCLE_SYNC_MON) {
+            ecrt_master_sync_monitor_queue(master);
+        }
+
+        if (data.operations & EC_CYCLE_QUEUE) {
+            for (i = 0; i < data.domain_count; i++) {
+                if (get_user(domain_index, &entries[i].domain_index)) {
+                    ret = -EFAULT;
+                    goto out_unlock;
+                }
+                if (!(domain = ec_master_find_domain(master, domain_index))) {
+                    ret = -ENOENT;
+                    goto out_unlock;
+                }
+                ecrt_domain_queue(domain);
+            }
+        }
+
+        ec_ioctl_lock_up(&master->io_sem);
+    }
+
+    if (data.operations & EC_CYCLE_SEND) {
+        ret = ec_ioctl_exec_send(master, &sent_bytes);
+        if (ret) {
+            return ret;
+        }
+
+        data.sent_bytes = sent_bytes;
+        if (copy_to_user((void __user *) arg, &data, sizeof(data))) {
+            return -EFAULT;
+        }
+    }
 
     return 0;
+
+out_unlock:
+    ec_ioctl_lock_up(&master->io_sem);
+    return ret;
 }
 
 /*****************************************************************************/
@@ -4301,7 +4761,8 @@ static ATTRIBUTES int ec_ioctl_foe_request_state(
 
     data.state = ecrt_foe_request_state(req);
     data.progress = ecrt_foe_request_progress(req);
-    if (data.state == EC_REQUEST_SUCCESS && req->dir == EC_DIR_INPUT)
+    if (data.state == EC_REQUEST_SUCCESS && req->dir == EC_DIR_INPUT
+            && !req->stream) // streamed data are pulled in chunks
         data.size = ecrt_foe_request_data_size(req);
     else
         data.size = 0;
@@ -4398,6 +4859,132 @@ static ATTRIBUTES int ec_ioctl_foe_request_write(
 
 /*****************************************************************************/
 
+/** Starts a streamed FoE transfer.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_foe_request_stream(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg, /**< ioctl() argument. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_ioctl_foe_request_t data;
+    ec_slave_config_t *sc;
+    ec_foe_request_t *req;
+
+    if (unlikely(!ctx->requested))
+        return -EPERM;
+
+    if (copy_from_user(&data, (void __user *) arg, sizeof(data)))
+        return -EFAULT;
+
+    /* no locking of master_sem needed, because neither sc nor req will not be
+     * deleted in the meantime. */
+
+    if (!(sc = ec_master_get_config(master, data.config_index))) {
+        return -ENOENT;
+    }
+
+    if (!(req = ec_slave_config_find_foe_request(sc, data.request_index))) {
+        return -ENOENT;
+    }
+
+    if (data.dir == EC_DIR_OUTPUT) {
+        ecrt_foe_request_stream_write(req);
+    } else {
+        ecrt_foe_request_stream_read(req);
+    }
+    return 0;
+}
+
+/*****************************************************************************/
+
+/** Pushes data to or pulls data from a streamed FoE transfer.
+ *
+ * The call does not block. \a size returns the number of bytes transferred.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_foe_request_stream_data(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg, /**< ioctl() argument. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_ioctl_foe_request_t data;
+    ec_slave_config_t *sc;
+    ec_foe_request_t *req;
+    size_t count = 0, chunk;
+    uint8_t *ptr;
+    const uint8_t *cptr;
+
+    if (unlikely(!ctx->requested))
+        return -EPERM;
+
+    if (copy_from_user(&data, (void __user *) arg, sizeof(data)))
+        return -EFAULT;
+
+    /* no locking of master_sem needed, because neither sc nor req will not be
+     * deleted in the meantime. */
+
+    if (!(sc = ec_master_get_config(master, data.config_index))) {
+        return -ENOENT;
+    }
+
+    if (!(req = ec_slave_config_find_foe_request(sc, data.request_index))) {
+        return -ENOENT;
+    }
+
+    if (!req->stream) {
+        return -EINVAL;
+    }
+
+    if (req->dir == EC_DIR_OUTPUT) {
+        if (req->stream_end) {
+            return -EINVAL;
+        }
+        while (count < data.size) {
+            ptr = ec_foe_request_stream_write_ptr(req, &chunk);
+            if (!chunk) {
+                break;
+            }
+            chunk = min(chunk, data.size - count);
+            if (copy_from_user(ptr,
+                        (void __user *) (data.data + count), chunk))
+                return -EFAULT;
+            ec_foe_request_stream_commit(req, chunk);
+            count += chunk;
+        }
+        if (data.last && count == data.size) {
+            smp_wmb(); // publish the fill level before the end mark
+            req->stream_end = 1;
+        }
+    } else {
+        while (count < data.size) {
+            cptr = ec_foe_request_stream_read_ptr(req, &chunk);
+            if (!chunk) {
+                break;
+            }
+            chunk = min(chunk, data.size - count);
+            if (copy_to_user((void __user *) (data.data + count),
+                        cptr, chunk))
+                return -EFAULT;
+            ec_foe_request_stream_release(req, chunk);
+            count += chunk;
+        }
+    }
+
+    data.size = count;
+
+    if (copy_to_user((void __user *) arg, &data, sizeof(data)))
+        return -EFAULT;
+
+    return 0;
+}
+
+/*****************************************************************************/
+
 /** Read FoE data.
  *
  * \return Zero on success, otherwise a negative error code.
@@ -5153,6 +5740,506 @@ static ATTRIBUTES int ec_ioctl_slave_foe_write(
 
 /*****************************************************************************/
 
+#ifndef EC_IOCTL_RTDM
+
+/** Schedules the streamed FoE transfer of a file handle.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static int ec_ioctl_foe_stream_start(
+        ec_master_t *master, /**< EtherCAT master. */
+        ec_ioctl_context_t *ctx, /**< Private data structure of file handle. */
+        const ec_ioctl_slave_foe_stream_t *io /**< Stream parameters. */
+        )
+{
+    ec_foe_request_t *req;
+    ec_slave_t *slave;
+    int ret;
+
+    req = kmalloc(sizeof(ec_foe_request_t), GFP_KERNEL);
+    if (!req) {
+        return -ENOMEM;
+    }
+
+    ec_foe_request_init(req);
+    ret = ec_foe_request_alloc(req, EC_FOE_STREAM_BUFFER_SIZE);
+    if (ret) {
+        ec_foe_request_clear(req);
+        kfree(req);
+        return ret;
+    }
+
+    ecrt_foe_request_file(req, io->file_name, io->password);
+    ec_foe_request_stream_start(req,
+            io->dir == EC_DIR_OUTPUT ? EC_DIR_OUTPUT : EC_DIR_INPUT);
+
+    if (ec_lock_down_interruptible(&master->master_sem)) {
+        ec_foe_request_clear(req);
+        kfree(req);
+        return -EINTR;
+    }
+
+    if (!(slave = ec_master_find_slave(master, 0, io->slave_position))) {
+        ec_lock_up(&master->master_sem);
+        EC_MASTER_ERR(master, "Slave %u does not exist!\n",
+                io->slave_position);
+        ec_foe_request_clear(req);
+        kfree(req);
+        return -EINVAL;
+    }
+
+    EC_SLAVE_DBG(slave, 1, "Scheduling streamed FoE %s request.\n",
+            req->dir == EC_DIR_OUTPUT ? "write" : "read");
+
+    list_add_tail(&req->list, &slave->foe_requests);
+
+    ec_lock_up(&master->master_sem);
+
+    ctx->foe_stream = req;
+    return 0;
+}
+
+/*****************************************************************************/
+
+/** Aborts and frees the streamed FoE transfer of a file handle.
+ */
+void ec_ioctl_foe_stream_abort(
+        ec_master_t *master, /**< EtherCAT master. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_foe_request_t *req = ctx->foe_stream;
+
+    if (!req) {
+        return;
+    }
+
+    ec_lock_down(&master->master_sem);
+    if (req->state == EC_INT_REQUEST_QUEUED) {
+        list_del(&req->list);
+        ec_lock_up(&master->master_sem);
+    } else {
+        ec_lock_up(&master->master_sem);
+
+        // the FSM terminates the transfer, when it waits for the stream
+        req->stream_abort = 1;
+        wait_event(master->request_queue,
+                req->state != EC_INT_REQUEST_BUSY);
+    }
+
+    ec_foe_request_clear(req);
+    kfree(req);
+    ctx->foe_stream = NULL;
+}
+
+/*****************************************************************************/
+
+/** Transfers a chunk of a streamed FoE transfer.
+ *
+ * The first call schedules the transfer. When writing, the call blocks until
+ * the chunk is copied to the stream buffer. When reading, the call blocks
+ * until data are available and returns at most \a size bytes. The transfer
+ * is finished with the last chunk, or when all data were read.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_slave_foe_stream(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg, /**< ioctl() argument. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_ioctl_slave_foe_stream_t io;
+    ec_foe_request_t *req;
+    size_t count = 0, chunk;
+    uint8_t *ptr;
+    const uint8_t *cptr;
+    int finished, ret = 0;
+
+    if (copy_from_user(&io, (void __user *) arg, sizeof(io))) {
+        return -EFAULT;
+    }
+
+    if (io.dir == EC_DIR_OUTPUT && !ctx->writable) {
+        return -EPERM;
+    }
+
+    if (!ctx->foe_stream) {
+        ret = ec_ioctl_foe_stream_start(master, ctx, &io);
+        if (ret) {
+            return ret;
+        }
+    }
+    req = ctx->foe_stream;
+
+    if ((io.dir == EC_DIR_OUTPUT) != (req->dir == EC_DIR_OUTPUT)) {
+        return -EBUSY;
+    }
+
+    if (req->dir == EC_DIR_OUTPUT) {
+        while (count < io.size) {
+            if (wait_event_interruptible(master->request_queue,
+                        ec_foe_request_stream_space(req)
+                        || req->state == EC_INT_REQUEST_FAILURE)) {
+                return -EINTR;
+            }
+            if (req->state == EC_INT_REQUEST_FAILURE) {
+                break;
+            }
+
+            ptr = ec_foe_request_stream_write_ptr(req, &chunk);
+            chunk = min(chunk, io.size - count);
+            if (copy_from_user(ptr,
+                        (void __user *) (io.buffer + count), chunk)) {
+                return -EFAULT;
+            }
+            ec_foe_request_stream_commit(req, chunk);
+            count += chunk;
+        }
+
+        if (io.last && count == io.size) {
+            smp_wmb(); // publish the fill level before the end mark
+            req->stream_end = 1;
+        }
+        finished = io.last || req->state == EC_INT_REQUEST_FAILURE;
+    } else {
+        if (wait_event_interruptible(master->request_queue,
+                    ec_foe_request_stream_fill(req)
+                    || (req->state != EC_INT_REQUEST_QUEUED
+                        && req->state != EC_INT_REQUEST_BUSY))) {
+            return -EINTR;
+        }
+
+        while (count < io.size) {
+            cptr = ec_foe_request_stream_read_ptr(req, &chunk);
+            if (!chunk) {
+                break;
+            }
+            chunk = min(chunk, io.size - count);
+            if (copy_to_user((void __user *) (io.buffer + count),
+                        cptr, chunk)) {
+                return -EFAULT;
+            }
+            ec_foe_request_stream_release(req, chunk);
+            count += chunk;
+        }
+        io.size = count;
+
+        finished = req->state != EC_INT_REQUEST_QUEUED
+            && req->state != EC_INT_REQUEST_BUSY;
+        smp_rmb(); // read the state before the fill level
+        finished = finished && !ec_foe_request_stream_fill(req);
+    }
+
+    io.done = 0;
+
+    if (finished) {
+        // wait until master FSM has finished processing
+        if (wait_event_interruptible(master->request_queue,
+                    req->state != EC_INT_REQUEST_QUEUED
+                    && req->state != EC_INT_REQUEST_BUSY)) {
+            return -EINTR;
+        }
+
+        io.done = 1;
+        ret = req->state == EC_INT_REQUEST_SUCCESS ? 0 : -EIO;
+    }
+
+    io.progress = req->progress;
+    io.result = req->result;
+    io.error_code = req->error_code;
+
+    if (io.done) {
+        ec_foe_request_clear(req);
+        kfree(req);
+        ctx->foe_stream = NULL;
+    }
+
+    if (__copy_to_user((void __user *) arg, &io, sizeof(io))) {
+        ret = -EFAULT;
+    }
+
+    return ret;
+}
+
+/*****************************************************************************/
+
+/** Interval in jiffies, after which a parallel FoE write reports progress.
+ */
+#define EC_IOCTL_FOE_BULK_INTERVAL (HZ / 5)
+
+/** Counts the requests of a parallel FoE write in a certain state.
+ *
+ * \return Number of requests in \a state.
+ */
+static unsigned int ec_ioctl_foe_bulk_count(
+        const ec_ioctl_foe_bulk_t *bulk, /**< Parallel FoE write. */
+        ec_internal_request_state_t state /**< Request state. */
+        )
+{
+    unsigned int i, count = 0;
+
+    for (i = 0; i < bulk->count; i++) {
+        if (bulk->requests[i].state == state) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*****************************************************************************/
+
+/** Frees a parallel FoE write.
+ *
+ * None of the requests may be queued or processed any more.
+ */
+static void ec_ioctl_foe_bulk_free(
+        ec_ioctl_foe_bulk_t *bulk /**< Parallel FoE write. */
+        )
+{
+    unsigned int i;
+
+    if (bulk->requests) {
+        for (i = 0; i < bulk->count; i++) {
+            ec_foe_request_clear(&bulk->requests[i]);
+        }
+        kfree(bulk->requests);
+    }
+
+    if (bulk->image) {
+        vfree(bulk->image);
+    }
+
+    kfree(bulk);
+}
+
+/*****************************************************************************/
+
+/** Schedules a parallel FoE write of a file handle.
+ *
+ * The file is copied to the kernel once. All requests use this copy and are
+ * queued at the same time, so that the slave state machines process them
+ * concurrently.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static int ec_ioctl_foe_bulk_start(
+        ec_master_t *master, /**< EtherCAT master. */
+        ec_ioctl_context_t *ctx, /**< Private data structure of file handle. */
+        const ec_ioctl_slave_foe_bulk_t *io /**< Transfer parameters. */
+        )
+{
+    ec_ioctl_foe_bulk_t *bulk;
+    ec_foe_request_t *req;
+    uint16_t *positions = NULL;
+    ec_slave_t *slave;
+    unsigned int i;
+    int ret = 0;
+
+    if (!io->slave_count || io->slave_count > master->slave_count) {
+        return -EINVAL;
+    }
+
+    if (!(bulk = kzalloc(sizeof(ec_ioctl_foe_bulk_t), GFP_KERNEL))) {
+        return -ENOMEM;
+    }
+
+    positions = kmalloc(io->slave_count * sizeof(uint16_t), GFP_KERNEL);
+    bulk->requests = kmalloc(io->slave_count * sizeof(ec_foe_request_t),
+            GFP_KERNEL);
+    if (!positions || !bulk->requests) {
+        ret = -ENOMEM;
+        goto out_free;
+    }
+
+    for (i = 0; i < io->slave_count; i++) {
+        ec_foe_request_init(&bulk->requests[i]);
+    }
+    bulk->count = io->slave_count;
+
+    if (copy_from_user(positions, (void __user *) io->slave_positions,
+                io->slave_count * sizeof(uint16_t))) {
+        ret = -EFAULT;
+        goto out_free;
+    }
+
+    if (io->buffer_size) {
+        if (!(bulk->image = vmalloc(io->buffer_size))) {
+            EC_MASTER_ERR(master, "Failed to allocate %zu bytes of FoE"
+                    " memory.\n", io->buffer_size);
+            ret = -ENOMEM;
+            goto out_free;
+        }
+        if (copy_from_user(bulk->image, (void __user *) io->buffer,
+                    io->buffer_size)) {
+            ret = -EFAULT;
+            goto out_free;
+        }
+    }
+
+    for (i = 0; i < bulk->count; i++) {
+        req = &bulk->requests[i];
+        ec_foe_request_borrow(req, bulk->image, io->buffer_size);
+        ecrt_foe_request_file(req, io->file_name, io->password);
+        ecrt_foe_request_write(req, io->buffer_size);
+    }
+
+    if (ec_lock_down_interruptible(&master->master_sem)) {
+        ret = -EINTR;
+        goto out_free;
+    }
+
+    // check all slaves, before anything is scheduled
+    for (i = 0; i < bulk->count; i++) {
+        if (!ec_master_find_slave(master, 0, positions[i])) {
+            ec_lock_up(&master->master_sem);
+            EC_MASTER_ERR(master, "Slave %u does not exist!\n",
+                    positions[i]);
+            ret = -EINVAL;
+            goto out_free;
+        }
+    }
+
+    EC_MASTER_DBG(master, 1, "Scheduling FoE write of %zu bytes"
+            " to %u slaves.\n", io->buffer_size, bulk->count);
+
+    for (i = 0; i < bulk->count; i++) {
+        slave = ec_master_find_slave(master, 0, positions[i]);
+        list_add_tail(&bulk->requests[i].list, &slave->foe_requests);
+    }
+
+    ec_lock_up(&master->master_sem);
+
+    bulk->jiffies_start = jiffies;
+    ctx->foe_bulk = bulk;
+    kfree(positions);
+    return 0;
+
+out_free:
+    kfree(positions);
+    ec_ioctl_foe_bulk_free(bulk);
+    return ret;
+}
+
+/*****************************************************************************/
+
+/** Aborts and frees the parallel FoE write of a file handle.
+ *
+ * Queued requests are removed, requests in progress are completed.
+ */
+void ec_ioctl_foe_bulk_abort(
+        ec_master_t *master, /**< EtherCAT master. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_ioctl_foe_bulk_t *bulk = ctx->foe_bulk;
+    ec_foe_request_t *req;
+    unsigned int i;
+
+    if (!bulk) {
+        return;
+    }
+
+    ec_lock_down(&master->master_sem);
+    for (i = 0; i < bulk->count; i++) {
+        req = &bulk->requests[i];
+        if (req->state == EC_INT_REQUEST_QUEUED) {
+            list_del(&req->list);
+            req->state = EC_INT_REQUEST_FAILURE;
+        }
+    }
+    ec_lock_up(&master->master_sem);
+
+    wait_event(master->request_queue,
+            !ec_ioctl_foe_bulk_count(bulk, EC_INT_REQUEST_BUSY));
+
+    ec_ioctl_foe_bulk_free(bulk);
+    ctx->foe_bulk = NULL;
+}
+
+/*****************************************************************************/
+
+/** Writes a file to multiple slaves via FoE in parallel.
+ *
+ * The first call schedules the transfers. Each call waits until all
+ * transfers are finished, but returns the per-slave progress at least every
+ * #EC_IOCTL_FOE_BULK_INTERVAL, so it has to be repeated until \a done is
+ * set.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static ATTRIBUTES int ec_ioctl_slave_foe_bulk(
+        ec_master_t *master, /**< EtherCAT master. */
+        void *arg, /**< ioctl() argument. */
+        ec_ioctl_context_t *ctx /**< Private data structure of file handle. */
+        )
+{
+    ec_ioctl_slave_foe_bulk_t io;
+    ec_ioctl_foe_bulk_slave_t status;
+    ec_ioctl_foe_bulk_t *bulk;
+    ec_foe_request_t *req;
+    unsigned int i;
+    int ret;
+
+    if (copy_from_user(&io, (void __user *) arg, sizeof(io))) {
+        return -EFAULT;
+    }
+
+    if (!ctx->foe_bulk) {
+        ret = ec_ioctl_foe_bulk_start(master, ctx, &io);
+        if (ret) {
+            return ret;
+        }
+    }
+    bulk = ctx->foe_bulk;
+
+    if (io.slave_count != bulk->count) {
+        return -EBUSY;
+    }
+
+    if (wait_event_interruptible_timeout(master->request_queue,
+                !ec_ioctl_foe_bulk_count(bulk, EC_INT_REQUEST_QUEUED)
+                && !ec_ioctl_foe_bulk_count(bulk, EC_INT_REQUEST_BUSY),
+                EC_IOCTL_FOE_BULK_INTERVAL) < 0) {
+        return -EINTR;
+    }
+
+    for (i = 0; i < bulk->count; i++) {
+        req = &bulk->requests[i];
+        status.state = ecrt_foe_request_state(req);
+        status.progress = req->progress;
+        status.result = req->result;
+        status.error_code = req->error_code;
+        if (copy_to_user((void __user *) (io.slaves + i), &status,
+                    sizeof(status))) {
+            return -EFAULT;
+        }
+    }
+
+    io.finished = ec_ioctl_foe_bulk_count(bulk, EC_INT_REQUEST_SUCCESS)
+        + ec_ioctl_foe_bulk_count(bulk, EC_INT_REQUEST_FAILURE);
+    io.done = io.finished == bulk->count;
+
+    if (io.done) {
+        EC_MASTER_DBG(master, 1, "Parallel FoE write to %u slaves finished"
+                " after %lu ms.\n", bulk->count,
+                (jiffies - bulk->jiffies_start) * 1000 / HZ);
+        ec_ioctl_foe_bulk_free(bulk);
+        ctx->foe_bulk = NULL;
+    }
+
+    if (__copy_to_user((void __user *) arg, &io, sizeof(io))) {
+        return -EFAULT;
+    }
+
+    return 0;
+}
+
+#endif
+
+/*****************************************************************************/
+
 /** Read an SoE IDN.
  *
  * \return Zero on success, otherwise a negative error code.
@@ -5496,6 +6583,18 @@ long EC_IOCTL(
             }
             ret = ec_ioctl_slave_sii_write(master, arg);
             break;
+#ifdef EC_SII_CACHE
+        case EC_IOCTL_SII_CACHE_READ:
+            ret = ec_ioctl_sii_cache_read(master, arg);
+            break;
+        case EC_IOCTL_SII_CACHE_LOAD:
+            if (!ctx->writable) {
+                ret = -EPERM;
+                break;
+            }
+            ret = ec_ioctl_sii_cache_load(master, arg);
+            break;
+#endif
         case EC_IOCTL_SLAVE_REG_READ:
             ret = ec_ioctl_slave_reg_read(master, arg);
             break;
@@ -5523,6 +6622,18 @@ long EC_IOCTL(
             }
             ret = ec_ioctl_slave_foe_write(master, arg);
             break;
+#ifndef EC_IOCTL_RTDM
+        case EC_IOCTL_SLAVE_FOE_STREAM:
+            ret = ec_ioctl_slave_foe_stream(master, arg, ctx);
+            break;
+        case EC_IOCTL_SLAVE_FOE_BULK:
+            if (!ctx->writable) {
+                ret = -EPERM;
+                break;
+            }
+            ret = ec_ioctl_slave_foe_bulk(master, arg, ctx);
+            break;
+#endif
         case EC_IOCTL_SLAVE_SOE_READ:
             ret = ec_ioctl_slave_soe_read(master, arg);
             break;
@@ -5802,6 +6913,13 @@ long EC_IOCTL(
             }
             ret = ec_ioctl_sc_reg_pdo_pos(master, arg, ctx);
             break;
+        case EC_IOCTL_SC_REG_ESC:
+            if (!ctx->writable) {
+                ret = -EPERM;
+                break;
+            }
+            ret = ec_ioctl_sc_reg_esc(master, arg, ctx);
+            break;
         case EC_IOCTL_SC_DC:
             if (!ctx->writable) {
                 ret = -EPERM;
@@ -5898,6 +7016,13 @@ long EC_IOCTL(
             }
             ret = ec_ioctl_domain_queue(master, arg, ctx);
             break;
+        case EC_IOCTL_CYCLE:
+            if (!ctx->writable) {
+                ret = -EPERM;
+                break;
+            }
+            ret = ec_ioctl_cycle(master, arg, ctx);
+            break;
         case EC_IOCTL_DOMAIN_STATE:
             ret = ec_ioctl_domain_state(master, arg, ctx);
             break;
@@ -5969,6 +7094,20 @@ long EC_IOCTL(
         case EC_IOCTL_FOE_REQUEST_DATA:
             ret = ec_ioctl_foe_request_data(master, arg, ctx);
             break;
+        case EC_IOCTL_FOE_REQUEST_STREAM:
+            if (!ctx->writable) {
+                ret = -EPERM;
+                break;
+            }
+            ret = ec_ioctl_foe_request_stream(master, arg, ctx);
+            break;
+        case EC_IOCTL_FOE_REQUEST_STREAM_DATA:
+            if (!ctx->writable) {
+                ret = -EPERM;
+                break;
+            }
+            ret = ec_ioctl_foe_request_stream_data(master, arg, ctx);
+            break;
         case EC_IOCTL_REG_REQUEST_DATA:
             ret = ec_ioctl_reg_request_data(master, arg, ctx);
             break;
@@ -6070,6 +7209,24 @@ long EC_IOCTL(
             }
             ret = ec_ioctl_mbox_gateway(master, arg, ctx);
             break;
+        case EC_IOCTL_MASTER_LATENCY:
+            ret = ec_ioctl_master_latency(master, arg);
+            break;
+        case EC_IOCTL_MASTER_LATENCY_RESET:
+            if (!ctx->writable) {
+                ret = -EPERM;
+                break;
+            }
+            ret = ec_ioctl_master_latency_reset(master, arg);
+            break;
+#ifndef EC_IOCTL_RTDM
+        case EC_IOCTL_EVENTS:
+            ret = ec_ioctl_events(master, arg, ctx);
+            break;
+        case EC_IOCTL_EVENTFD:
+            ret = ec_ioctl_eventfd(master, arg, ctx);
+            break;
+#endif
         default:
             ret = -ENOTTY;
             break;
@@ -56,7 +56,7 @@
  *
  * Increment this when changing the ioctl interface!
  */
-#define EC_IOCTL_VERSION_MAGIC 36
+#define EC_IOCTL_VERSION_MAGIC 51
 
 // Command-line tool
 #define EC_IOCTL_MODULE                EC_IOR(0x00, ec_ioctl_module_t)
@@ -191,6 +191,40 @@
 // Mailbox Gateway
 #define EC_IOCTL_MBOX_GATEWAY         EC_IOWR(0x73, ec_ioctl_mbox_gateway_t)
 
+// Latency statistics
+#define EC_IOCTL_MASTER_LATENCY       EC_IOWR(0x74, ec_ioctl_master_latency_t)
+#define EC_IOCTL_MASTER_LATENCY_RESET EC_IO(0x75)
+
+// Batched cyclic operations
+#define EC_IOCTL_CYCLE                EC_IOWR(0x76, ec_ioctl_cycle_t)
+
+/** Operations supported by ecrt_master_cycle().
+ */
+#define EC_IOCTL_CYCLE_OPERATIONS (EC_CYCLE_RECEIVE | EC_CYCLE_PROCESS \
+        | EC_CYCLE_APP_TIME | EC_CYCLE_SYNC_REF | EC_CYCLE_SYNC_REF_TO \
+        | EC_CYCLE_SYNC_SLAVES | EC_CYCLE_SYNC_MON | EC_CYCLE_QUEUE \
+        | EC_CYCLE_SEND)
+
+// Event notification
+#define EC_IOCTL_EVENTS               EC_IOWR(0x77, ec_ioctl_events_t)
+#define EC_IOCTL_EVENTFD              EC_IOW(0x78, ec_ioctl_eventfd_t)
+
+// Process data mapped ESC registers
+#define EC_IOCTL_SC_REG_ESC           EC_IOWR(0x79, ec_ioctl_reg_esc_t)
+
+// Persistent SII cache
+#define EC_IOCTL_SII_CACHE_READ       EC_IOWR(0x7a, ec_ioctl_sii_cache_t)
+#define EC_IOCTL_SII_CACHE_LOAD        EC_IOW(0x7b, ec_ioctl_sii_cache_t)
+
+// Streamed FoE transfers
+#define EC_IOCTL_SLAVE_FOE_STREAM     EC_IOWR(0x7c, ec_ioctl_slave_foe_stream_t)
+#define EC_IOCTL_FOE_REQUEST_STREAM   EC_IOWR(0x7d, ec_ioctl_foe_request_t)
+#define EC_IOCTL_FOE_REQUEST_STREAM_DATA \
+                                      EC_IOWR(0x7e, ec_ioctl_foe_request_t)
+
+// Parallel FoE write to multiple slaves
+#define EC_IOCTL_SLAVE_FOE_BULK       EC_IOWR(0x80, ec_ioctl_slave_foe_bulk_t)
+
 /*****************************************************************************/
 
 #define EC_IOCTL_STRING_SIZE 64
@@ -214,6 +248,11 @@ typedef struct {
     uint8_t phase;
     uint8_t active;
     uint8_t scan_busy;
+    uint8_t scan_incremental;
+    uint32_t scan_duration;
+    uint8_t op_pending;
+    uint8_t op_grouped;
+    uint32_t op_duration;
     struct ec_ioctl_device {
         uint8_t address[6];
         uint8_t attached;
@@ -238,6 +277,14 @@ typedef struct {
     int32_t tx_byte_rates[EC_RATE_COUNT];
     int32_t rx_byte_rates[EC_RATE_COUNT];
     int32_t loss_rates[EC_RATE_COUNT];
+    uint64_t cycle_count;
+    uint64_t cycle_frames;
+    uint64_t cycle_frame_bytes;
+    uint32_t last_cycle_frames;
+    uint64_t timeouts;
+    uint32_t last_cycle_timeouts;
+    uint64_t mbox_status_reads;
+    uint64_t mbox_status_checks;
     uint64_t app_time;
     uint64_t dc_ref_time;
     uint16_t ref_clock;
@@ -290,6 +337,8 @@ typedef struct {
     uint8_t sync_count;
     uint16_t sdo_count;
     uint32_t sii_nwords;
+    uint32_t config_duration;
+    uint32_t config_round_trips;
     char group[EC_IOCTL_STRING_SIZE];
     char image[EC_IOCTL_STRING_SIZE];
     char order[EC_IOCTL_STRING_SIZE];
@@ -353,6 +402,7 @@ typedef struct {
     uint16_t working_counter[EC_MAX_NUM_DEVICES];
     uint16_t expected_working_counter;
     uint32_t fmmu_count;
+    uint64_t copied_bytes;
 } ec_ioctl_domain_t;
 
 /*****************************************************************************/
@@ -391,6 +441,64 @@ typedef struct {
 
 /*****************************************************************************/
 
+typedef struct {
+    // inputs
+    uint32_t device_index;
+    uint32_t datagram_class;
+
+    // outputs
+    uint64_t count;
+    uint64_t sum_ns;
+    uint32_t min_ns;
+    uint32_t max_ns;
+    uint64_t bins[EC_LATENCY_BIN_COUNT];
+} ec_ioctl_master_latency_t;
+
+/*****************************************************************************/
+
+typedef struct {
+    // input
+    uint32_t domain_index;
+
+    // output
+    ec_domain_state_t state;
+} ec_ioctl_cycle_domain_t;
+
+/*****************************************************************************/
+
+typedef struct {
+    // inputs
+    uint32_t operations;
+    uint64_t app_time;
+    uint64_t sync_time;
+    uint32_t domain_count;
+    ec_ioctl_cycle_domain_t *domains;
+
+    // output
+    size_t sent_bytes;
+} ec_ioctl_cycle_t;
+
+/*****************************************************************************/
+
+typedef struct {
+    // inputs
+    uint32_t select; // non-zero to replace the selected events
+    uint32_t events;
+
+    // output
+    uint32_t pending;
+} ec_ioctl_events_t;
+
+/*****************************************************************************/
+
+typedef struct {
+    // inputs
+    int32_t fd;
+    uint32_t events;
+} ec_ioctl_eventfd_t;
+
+/*****************************************************************************/
+
 typedef struct {
     // inputs
     uint16_t slave_position;
@@ -469,6 +577,18 @@ typedef struct {
 
 /*****************************************************************************/
 
+typedef struct {
+    // inputs
+    uint32_t index;
+    uint32_t nwords; // buffer size on input, image size on output
+    uint16_t *words;
+
+    // outputs
+    uint32_t count;
+} ec_ioctl_sii_cache_t;
+
+/*****************************************************************************/
+
 typedef struct {
     // inputs
     uint16_t slave_position;
@@ -506,6 +626,54 @@ typedef struct {
 
 /*****************************************************************************/
 
+typedef struct {
+    // inputs
+    uint32_t password;
+    uint16_t slave_position;
+    uint8_t dir;
+    uint8_t last;
+    uint8_t *buffer;
+
+    // inputs/outputs
+    size_t size;
+
+    // outputs
+    size_t progress;
+    uint8_t done;
+    uint32_t result;
+    uint32_t error_code;
+
+    char file_name[255];
+} ec_ioctl_slave_foe_stream_t;
+
+/*****************************************************************************/
+
+typedef struct {
+    // outputs
+    size_t progress;
+    uint32_t result;
+    uint32_t error_code;
+    uint8_t state;
+} ec_ioctl_foe_bulk_slave_t;
+
+typedef struct {
+    // inputs
+    uint32_t password;
+    uint32_t slave_count;
+    uint16_t *slave_positions;
+    size_t buffer_size;
+    uint8_t *buffer;
+    ec_ioctl_foe_bulk_slave_t *slaves;
+
+    // outputs
+    uint32_t finished;
+    uint8_t done;
+
+    char file_name[255];
+} ec_ioctl_slave_foe_bulk_t;
+
+/*****************************************************************************/
+
 typedef struct {
     // inputs
     uint16_t slave_position;
@@ -699,6 +867,8 @@ typedef struct {
     // outputs
     void *process_data;
     size_t process_data_size;
+    size_t status_size;
+    size_t ring_size;
 } ec_ioctl_master_activate_t;
 
 /*****************************************************************************/
@@ -741,6 +911,16 @@ typedef struct {
 
 /*****************************************************************************/
 
+typedef struct {
+    // inputs
+    uint32_t config_index;
+    uint16_t address;
+    uint16_t size;
+    uint32_t domain_index;
+} ec_ioctl_reg_esc_t;
+
+/*****************************************************************************/
+
 typedef struct {
     // inputs
     uint32_t config_index;
@@ -828,6 +1008,8 @@ typedef struct {
     ec_request_state_t state;
     ec_foe_error_t result;
     uint32_t error_code;
+    uint8_t dir;
+    uint8_t last;
 
     char file_name[255];
 } ec_ioctl_foe_request_t;
@@ -891,8 +1073,150 @@ typedef struct {
 
 /*****************************************************************************/
 
+/** Offset of the status page in the memory mapping of the master.
+ *
+ * The status page can be mapped read-only after activation, if the \a
+ * status_size returned by EC_IOCTL_ACTIVATE is non-zero.
+ */
+#define EC_IOCTL_STATUS_OFFSET 0x40000000
+
+/** Domain entry of the status page.
+ *
+ * Every entry is protected by its own sequence number, because the domains
+ * may be processed by different application tasks.
+ */
+typedef struct {
+    uint32_t sequence; /**< Odd while the entry is updated. */
+    ec_domain_state_t state; /**< Domain state after the last processing. */
+} ec_ioctl_status_domain_t;
+
+/** Status page header.
+ *
+ * The header is followed by \a domain_count domain entries (in the order of
+ * the domain indices) and \a config_count slave configuration states (in
+ * the order of the configuration indices).
+ */
+typedef struct ec_ioctl_status {
+    uint32_t sequence; /**< Odd while the master, link and slave
+                         configuration states are updated. */
+    uint32_t domain_count; /**< Number of domain entries. */
+    uint32_t config_count; /**< Number of slave configuration states. */
+    uint32_t device_count; /**< Number of valid link states. */
+    ec_master_state_t master_state; /**< Master state. */
+    ec_master_link_state_t link_states[EC_MAX_NUM_DEVICES]; /**< Link
+                                                              states. */
+} ec_ioctl_status_t;
+
+/** Domain entries of a status page. */
+#define EC_IOCTL_STATUS_DOMAINS(STATUS) \
+    ((ec_ioctl_status_domain_t *) ((STATUS) + 1))
+
+/** Slave configuration states of a status page. */
+#define EC_IOCTL_STATUS_CONFIGS(STATUS) \
+    ((ec_slave_config_state_t *) \
+     (EC_IOCTL_STATUS_DOMAINS(STATUS) + (STATUS)->domain_count))
+
+/*****************************************************************************/
+
+/** Offset of the request ring in the memory mapping of the master.
+ *
+ * The request ring can be mapped read-write after activation, if the \a
+ * ring_size returned by EC_IOCTL_ACTIVATE is non-zero.
+ */
+#define EC_IOCTL_RING_OFFSET 0x50000000
+
+/** Request types of the request ring entries.
+ */
+enum {
+    EC_IOCTL_RING_SDO, /**< SDO request. */
+    EC_IOCTL_RING_REG, /**< Register request. */
+    EC_IOCTL_RING_FOE /**< FoE request. */
+};
+
+/** Commands of request ring submissions.
+ */
+enum {
+    EC_IOCTL_RING_READ, /**< Start a read operation. */
+    EC_IOCTL_RING_WRITE, /**< Start a write operation. */
+    EC_IOCTL_RING_READWRITE /**< Start a read-write operation (register
+                              requests only). */
+};
+
+/** Submission slot of the request ring.
+ */
+typedef struct ec_ioctl_ring_sub {
+    uint32_t entry; /**< Index of the request entry. */
+    uint16_t command; /**< Command (EC_IOCTL_RING_READ, ...). */
+    uint16_t address; /**< Register address (register requests only). */
+    uint32_t size; /**< Transfer size. For write operations, the data have
+                     to be placed in the data area of the entry. */
+} ec_ioctl_ring_sub_t;
+
+/** Request entry of the request ring.
+ *
+ * There is one entry per SDO, register and FoE request existing at
+ * activation time. Only the master writes the entries.
+ */
+typedef struct ec_ioctl_ring_entry {
+    uint32_t type; /**< Request type (EC_IOCTL_RING_SDO, ...). */
+    uint32_t config_index; /**< Slave configuration index. */
+    uint32_t request_index; /**< Request index in the configuration. */
+    uint32_t mem_size; /**< Size of the data area. */
+    uint32_t data_offset; /**< Offset of the data area in the ring. */
+    uint32_t sequence; /**< Number of submissions consumed by the master. The
+                         state belongs to the last of them. */
+    ec_request_state_t state; /**< Request state. */
+    uint32_t data_size; /**< Size of the received data in the data area, if
+                          \a state is EC_REQUEST_SUCCESS, otherwise zero. */
+    uint32_t progress; /**< FoE transfer progress. */
+    uint32_t result; /**< FoE result. */
+    uint32_t error_code; /**< FoE error code. */
+} ec_ioctl_ring_entry_t;
+
+/** Request ring header.
+ *
+ * The header is followed by \a sub_count submission slots, the \a
+ * entry_count request entries and the data areas of the entries. The
+ * application produces submissions at \a sub_head, the master consumes them
+ * at \a sub_tail and publishes the results in the request entries.
+ */
+typedef struct ec_ioctl_ring {
+    uint32_t sub_head; /**< Submission head (written by the application). */
+    uint32_t sub_tail; /**< Submission tail (written by the master). */
+    uint32_t sub_count; /**< Number of submission slots (power of two). */
+    uint32_t entry_count; /**< Number of request entries. */
+} ec_ioctl_ring_t;
+
+/** Submission slots of a request ring. */
+#define EC_IOCTL_RING_SUBS(RING) \
+    ((ec_ioctl_ring_sub_t *) ((RING) + 1))
+
+/** Request entries of a request ring. */
+#define EC_IOCTL_RING_ENTRIES(RING) \
+    ((ec_ioctl_ring_entry_t *) \
+     (EC_IOCTL_RING_SUBS(RING) + (RING)->sub_count))
+
+/*****************************************************************************/
+
 #ifdef __KERNEL__
 
+/** Binding of master events to an eventfd.
+ */
+typedef struct ec_event_binding {
+    struct list_head list; /**< List item of the master's bindings. */
+    struct eventfd_ctx *eventfd; /**< eventfd context, or NULL. */
+    uint32_t events; /**< Bound events (\a EC_EVENT_* values). */
+} ec_event_binding_t;
+
+/** Parallel FoE write to multiple slaves.
+ */
+typedef struct {
+    uint8_t *image; /**< File image shared by all requests. */
+    ec_foe_request_t *requests; /**< One write request per slave. */
+    unsigned int count; /**< Number of \a requests. */
+    unsigned long jiffies_start; /**< Start of the transfers. */
+} ec_ioctl_foe_bulk_t;
+
 /** Context data structure for file handles.
  */
 typedef struct {
@@ -900,10 +1224,20 @@ typedef struct {
     unsigned int requested; /**< Master was requested via this file handle. */
     uint8_t *process_data; /**< Total process data area. */
     size_t process_data_size; /**< Size of the \a process_data. */
+    uint32_t events; /**< Events selected for poll(). */
+    unsigned int event_acks[EC_EVENT_COUNT]; /**< Event counters at the last
+                                               acknowledge. */
+    ec_event_binding_t event_binding; /**< eventfd binding. */
+    ec_foe_request_t *foe_stream; /**< Streamed FoE transfer of the file
+                                    handle, or NULL. */
+    ec_ioctl_foe_bulk_t *foe_bulk; /**< Parallel FoE write of the file
+                                     handle, or NULL. */
 } ec_ioctl_context_t;
 
 long ec_ioctl(ec_master_t *, ec_ioctl_context_t *, unsigned int,
         void __user *);
+void ec_ioctl_foe_stream_abort(ec_master_t *, ec_ioctl_context_t *);
+void ec_ioctl_foe_bulk_abort(ec_master_t *, ec_ioctl_context_t *);
 
 #ifdef EC_RTDM
 
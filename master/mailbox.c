@@ -109,6 +109,12 @@ int ec_slave_mbox_prepare_check(const ec_slave_t *slave, /**< slave */
         return ret;
 
     ec_datagram_zero(datagram);
+
+    if (slave->mbox_status_mapped) {
+        // answered by the master's mailbox status datagram
+        datagram->mbox_status = slave->master->mbox_status_datagram.data +
+            (slave - slave->master->slaves);
+    }
     return 0;
 }
 
@@ -126,6 +132,61 @@ int ec_slave_mbox_check(const ec_datagram_t *datagram /**< datagram */)
 
 /*****************************************************************************/
 
+/** Configures an FMMU mapping the mailbox status.
+ *
+ * The status register of the sync manager used for the send mailbox (the one
+ * starting at the configured send mailbox offset) is mapped to \a
+ * EC_MBOX_STATUS_ADDRESS plus the slave's index. The last FMMU of the slave
+ * is used, if it is not needed for process data.
+ *
+ * \return Non-zero, if the FMMU configuration page was written.
+ */
+int ec_slave_mbox_status_fmmu(
+        const ec_slave_t *slave, /**< slave */
+        unsigned int used_fmmus, /**< Number of FMMUs used for process
+                                   data. */
+        uint8_t *data /**< FMMU configuration pages. */
+        )
+{
+    unsigned int index = slave - slave->master->slaves, sm_index;
+
+    if (!mbox_status_fmmu || !slave->sii_image
+            || !slave->sii_image->sii.mailbox_protocols
+            || slave->device_index != EC_DEVICE_MAIN
+            || index >= EC_MAX_DATA_SIZE
+            || used_fmmus >= slave->base_fmmu_count) {
+        return 0;
+    }
+
+    for (sm_index = 0; sm_index < slave->sii_image->sii.sync_count;
+            sm_index++) {
+        if (slave->sii_image->sii.syncs[sm_index].physical_start_address
+                == slave->configured_tx_mailbox_offset) {
+            break;
+        }
+    }
+    if (sm_index == slave->sii_image->sii.sync_count) {
+        return 0; // send mailbox sync manager unknown
+    }
+
+    EC_SLAVE_DBG(slave, 1, "Mapping mailbox status of SM%u to 0x%08X.\n",
+            sm_index, EC_MBOX_STATUS_ADDRESS + index);
+
+    data += EC_FMMU_PAGE_SIZE * (slave->base_fmmu_count - 1);
+    EC_WRITE_U32(data,      EC_MBOX_STATUS_ADDRESS + index);
+    EC_WRITE_U16(data + 4,  1); // size of fmmu
+    EC_WRITE_U8 (data + 6,  0x00); // logical start bit
+    EC_WRITE_U8 (data + 7,  0x07); // logical end bit
+    EC_WRITE_U16(data + 8,  0x0805 + 8 * sm_index); // SM status register
+    EC_WRITE_U8 (data + 10, 0x00); // physical start bit
+    EC_WRITE_U8 (data + 11, 0x01); // read access
+    EC_WRITE_U16(data + 12, 0x0001); // enable
+    EC_WRITE_U16(data + 14, 0x0000); // reserved
+    return 1;
+}
+
+/*****************************************************************************/
+
 /**
    Prepares a datagram to fetch mailbox data.
    \return 0 in case of success, else < 0
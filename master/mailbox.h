@@ -45,6 +45,13 @@
  */
 #define EC_MBOX_HEADER_SIZE 6
 
+/** Logical address of the mailbox status region.
+ *
+ * If enabled via the mbox_status_fmmu module parameter, the mailbox status
+ * of each slave is mapped to this address plus the slave's index.
+ */
+#define EC_MBOX_STATUS_ADDRESS 0xFFFF0000
+
 /** Mailbox types.
  *
  * These are used in the 'Type' field of the mailbox header.
@@ -72,6 +79,8 @@ uint8_t *ec_slave_mbox_prepare_send(const ec_slave_t *, ec_datagram_t *,
                                     uint8_t, size_t);
 int      ec_slave_mbox_prepare_check(const ec_slave_t *, ec_datagram_t *);
 int      ec_slave_mbox_check(const ec_datagram_t *);
+int      ec_slave_mbox_status_fmmu(const ec_slave_t *, unsigned int,
+                                   uint8_t *);
 int      ec_slave_mbox_prepare_fetch(const ec_slave_t *, ec_datagram_t *);
 uint8_t *ec_slave_mbox_fetch(const ec_slave_t *, ec_mbox_data_t *,
                              uint8_t *, size_t *);
@@ -45,6 +45,9 @@
 #include <linux/version.h>
 #include <linux/hrtimer.h>
 #include <linux/vmalloc.h>
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 31)
+#include <linux/eventfd.h>
+#endif
 
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 11, 0)
 #include <linux/sched/types.h> // struct sched_param
@@ -61,6 +64,7 @@
 #include "ethernet.h"
 #endif
 #include "master.h"
+#include "ioctl.h"
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4,11,0)
 #include <linux/sched/signal.h>
 #include <uapi/linux/sched/types.h>
@@ -116,6 +120,7 @@ static int ec_master_eoe_thread(void *);
 void ec_master_find_dc_ref_clock(ec_master_t *);
 void ec_master_clear_device_stats(ec_master_t *);
 void ec_master_update_device_stats(ec_master_t *);
+static void ec_master_status_free(ec_master_t *);
 
 /*****************************************************************************/
 
@@ -175,11 +180,17 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 #endif
 
     ec_master_clear_device_stats(master);
+    ec_master_clear_latency_stats(master);
 
     ec_lock_init(&master->device_sem);
 
     master->phase = EC_ORPHANED;
     master->active = 0;
+    master->activate_jiffies = 0;
+    master->op_pending = 0;
+    master->op_duration = 0;
+    master->op_grouped = 0;
+    master->group_op = 0;
     master->config_changed = 0;
     master->injection_seq_fsm = 0;
     master->injection_seq_rt = 0;
@@ -187,6 +198,7 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 
     master->slaves = NULL;
     master->slave_count = 0;
+    master->slave_capacity = 0;
 
     INIT_LIST_HEAD(&master->configs);
     INIT_LIST_HEAD(&master->domains);
@@ -197,6 +209,8 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
     master->dc_offset_valid = 0;
 
     master->scan_busy = 0;
+    master->scan_duration = 0;
+    master->scan_incremental = 0;
     master->allow_scan = 1;
     ec_lock_init(&master->scan_sem);
     init_waitqueue_head(&master->scan_queue);
@@ -207,6 +221,10 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 
     INIT_LIST_HEAD(&master->datagram_queue);
     master->datagram_index = 0;
+    INIT_LIST_HEAD(&master->sent_queue);
+    for (i = 0; i < EC_DATAGRAM_INDEX_COUNT; i++) {
+        master->datagram_table[i] = NULL;
+    }
 
     INIT_LIST_HEAD(&master->ext_datagram_queue);
     ec_lock_init(&master->ext_queue_sem);
@@ -220,7 +238,9 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
     for (i = 0; i < EC_EXT_RING_SIZE; i++) {
         ec_datagram_t *datagram = &master->ext_datagram_ring[i];
         ec_datagram_init(datagram);
+        datagram->traffic_class = EC_DATAGRAM_CLASS_SLAVE_FSM;
         snprintf(datagram->name, EC_DATAGRAM_NAME_SIZE, "ext-%u", i);
+        master->ext_ring[i] = NULL;
     }
 
     // send interval in IDLE phase
@@ -232,6 +252,8 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 
     master->debug_level = debug_level;
     master->stats.timeouts = 0;
+    master->stats.last_cycle_timeouts = 0;
+    master->stats.total_timeouts = 0;
     master->stats.corrupted = 0;
     master->stats.unmatched = 0;
     master->stats.output_jiffies = 0;
@@ -243,6 +265,10 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
         master->pcap_data = NULL;
     }
     master->pcap_curr_data = master->pcap_data;
+
+    master->status = NULL;
+    master->status_size = 0;
+    ec_request_ring_init(&master->request_ring, master);
     
     master->thread = NULL;
 
@@ -264,6 +290,12 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 
     init_waitqueue_head(&master->request_queue);
 
+    init_waitqueue_head(&master->event_queue);
+    spin_lock_init(&master->event_lock);
+    memset(master->event_counts, 0x00, sizeof(master->event_counts));
+    master->events_posted = 0;
+    INIT_LIST_HEAD(&master->event_bindings);
+
     // init devices
     for (dev_idx = EC_DEVICE_MAIN; dev_idx < ec_master_num_devices(master);
             dev_idx++) {
@@ -275,6 +307,7 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 
     // init state machine datagram
     ec_datagram_init(&master->fsm_datagram);
+    master->fsm_datagram.traffic_class = EC_DATAGRAM_CLASS_FSM;
     snprintf(master->fsm_datagram.name, EC_DATAGRAM_NAME_SIZE, "master-fsm");
     ret = ec_datagram_prealloc(&master->fsm_datagram, EC_MAX_DATA_SIZE);
     if (ret < 0) {
@@ -299,6 +332,7 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 
     // init reference sync datagram
     ec_datagram_init(&master->ref_sync_datagram);
+    master->ref_sync_datagram.traffic_class = EC_DATAGRAM_CLASS_DC;
     snprintf(master->ref_sync_datagram.name, EC_DATAGRAM_NAME_SIZE,
             "refsync");
     ret = ec_datagram_prealloc(&master->ref_sync_datagram, 4);
@@ -311,6 +345,7 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 
     // init sync datagram
     ec_datagram_init(&master->sync_datagram);
+    master->sync_datagram.traffic_class = EC_DATAGRAM_CLASS_DC;
     snprintf(master->sync_datagram.name, EC_DATAGRAM_NAME_SIZE, "sync");
     ret = ec_datagram_prealloc(&master->sync_datagram, 4);
     if (ret < 0) {
@@ -322,6 +357,7 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 
     // init sync64 datagram
     ec_datagram_init(&master->sync64_datagram);
+    master->sync64_datagram.traffic_class = EC_DATAGRAM_CLASS_DC;
     snprintf(master->sync64_datagram.name, EC_DATAGRAM_NAME_SIZE, "sync64");
     ret = ec_datagram_prealloc(&master->sync64_datagram, 8);
     if (ret < 0) {
@@ -333,6 +369,7 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
 
     // init sync monitor datagram
     ec_datagram_init(&master->sync_mon_datagram);
+    master->sync_mon_datagram.traffic_class = EC_DATAGRAM_CLASS_DC;
     snprintf(master->sync_mon_datagram.name, EC_DATAGRAM_NAME_SIZE,
             "syncmon");
     ret = ec_datagram_brd(&master->sync_mon_datagram, 0x092c, 4);
@@ -343,13 +380,32 @@ int ec_master_init(ec_master_t *master, /**< EtherCAT master */
         goto out_clear_sync64;
     }
 
+    // init mailbox status datagram
+    ec_datagram_init(&master->mbox_status_datagram);
+    master->mbox_status_datagram.traffic_class = EC_DATAGRAM_CLASS_SLAVE_FSM;
+    snprintf(master->mbox_status_datagram.name, EC_DATAGRAM_NAME_SIZE,
+            "mboxstat");
+    ret = ec_datagram_prealloc(&master->mbox_status_datagram,
+            EC_MAX_DATA_SIZE);
+    if (ret < 0) {
+        ec_datagram_clear(&master->mbox_status_datagram);
+        EC_MASTER_ERR(master, "Failed to allocate mailbox"
+                " status datagram.\n");
+        goto out_clear_sync_mon;
+    }
+    INIT_LIST_HEAD(&master->mbox_check_queue);
+    INIT_LIST_HEAD(&master->mbox_check_sent);
+    master->mbox_status_wc = 0;
+    master->mbox_status_reads = 0;
+    master->mbox_status_checks = 0;
+
     master->dc_ref_config = NULL;
     master->dc_ref_clock = NULL;
 
     // init character device
     ret = ec_cdev_init(&master->cdev, master, device_number);
     if (ret)
-        goto out_clear_sync_mon;
+        goto out_clear_mbox_status;
 
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 27)
     master->class_device = device_create(class, NULL,
@@ -394,6 +450,8 @@ out_unregister_class_device:
 #endif
 out_clear_cdev:
     ec_cdev_clear(&master->cdev);
+out_clear_mbox_status:
+    ec_datagram_clear(&master->mbox_status_datagram);
 out_clear_sync_mon:
     ec_datagram_clear(&master->sync_mon_datagram);
 out_clear_sync64:
@@ -447,6 +505,7 @@ void ec_master_clear(
     ec_master_clear_slaves(master);
     ec_master_clear_sii_images(master);
 
+    ec_datagram_clear(&master->mbox_status_datagram);
     ec_datagram_clear(&master->sync_mon_datagram);
     ec_datagram_clear(&master->sync64_datagram);
     ec_datagram_clear(&master->sync_datagram);
@@ -464,6 +523,9 @@ void ec_master_clear(
         ec_device_clear(&master->devices[dev_idx]);
     }
     
+    ec_master_status_free(master);
+    ec_request_ring_clear(&master->request_ring);
+
     if (master->pcap_data) {
         vfree(master->pcap_data);
         master->pcap_data = NULL;
@@ -575,6 +637,154 @@ void ec_master_clear_sii_images(
     }
 }
 
+#ifdef EC_SII_CACHE
+/*****************************************************************************/
+
+/** Checks, if an SII image may be stored in the persistent SII cache.
+ *
+ * The image has to be complete, and the slave has to be uniquely
+ * identifiable by its alias or serial number.
+ */
+static int ec_sii_image_cacheable(
+        const ec_sii_image_t *sii_image /**< SII image. */
+        )
+{
+    return sii_image->nwords >= EC_FIRST_SII_CATEGORY_OFFSET
+        && (sii_image->sii.alias || sii_image->sii.serial_number);
+}
+
+/*****************************************************************************/
+
+/** Get the number of SII images eligible for the persistent SII cache.
+ *
+ * \return Number of cacheable SII images.
+ */
+unsigned int ec_master_sii_cache_count(
+        const ec_master_t *master /**< EtherCAT master. */
+        )
+{
+    const ec_sii_image_t *sii_image;
+    unsigned int count = 0;
+
+    list_for_each_entry(sii_image, &master->sii_images, list) {
+        if (ec_sii_image_cacheable(sii_image)) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*****************************************************************************/
+
+/** Get an SII image eligible for the persistent SII cache by its position.
+ *
+ * \return SII image, or NULL if the index is out of range.
+ */
+const ec_sii_image_t *ec_master_get_cached_sii_image(
+        const ec_master_t *master, /**< EtherCAT master. */
+        unsigned int index /**< Index among the cacheable images. */
+        )
+{
+    const ec_sii_image_t *sii_image;
+
+    list_for_each_entry(sii_image, &master->sii_images, list) {
+        if (!ec_sii_image_cacheable(sii_image)) {
+            continue;
+        }
+        if (index--) {
+            continue;
+        }
+        return sii_image;
+    }
+
+    return NULL;
+}
+
+/*****************************************************************************/
+
+/** Adds an SII image from the persistent SII cache.
+ *
+ * The image is stored as raw SII words only. When a slave with matching
+ * identity is scanned, the image is validated against the slave's SII
+ * checksum and parsed, instead of reading the whole SII from the slave.
+ * Images already present are not replaced.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+int ec_master_add_cached_sii_image(
+        ec_master_t *master, /**< EtherCAT master. */
+        const uint16_t *words, /**< SII contents. */
+        size_t nwords /**< Number of SII words. */
+        )
+{
+    ec_sii_image_t *sii_image;
+    uint16_t alias;
+    uint32_t vendor_id, product_code, revision_number, serial_number;
+
+    if (nwords < EC_FIRST_SII_CATEGORY_OFFSET || nwords > EC_MAX_SII_SIZE) {
+        EC_MASTER_ERR(master, "Invalid cached SII image size %zu.\n",
+                nwords);
+        return -EINVAL;
+    }
+
+    alias = EC_READ_U16(words + EC_ALIAS_SII_OFFSET);
+    vendor_id = EC_READ_U32(words + EC_VENDOR_SII_OFFSET);
+    product_code = EC_READ_U32(words + EC_PRODUCT_SII_OFFSET);
+    revision_number = EC_READ_U32(words + EC_REVISION_SII_OFFSET);
+    serial_number = EC_READ_U32(words + EC_SERIAL_SII_OFFSET);
+
+    if (!alias && !serial_number) {
+        EC_MASTER_ERR(master, "Cached SII image of vendor 0x%08x,"
+                " product 0x%08x is not uniquely identifiable.\n",
+                vendor_id, product_code);
+        return -EINVAL;
+    }
+
+    list_for_each_entry(sii_image, &master->sii_images, list) {
+        if (sii_image->sii.alias == alias
+                && sii_image->sii.vendor_id == vendor_id
+                && sii_image->sii.product_code == product_code
+                && sii_image->sii.revision_number == revision_number
+                && sii_image->sii.serial_number == serial_number) {
+            return 0;
+        }
+    }
+
+    if (!(sii_image = kmalloc(sizeof(ec_sii_image_t), GFP_KERNEL))) {
+        EC_MASTER_ERR(master, "Failed to allocate memory"
+                " for cached SII image.\n");
+        return -ENOMEM;
+    }
+    ec_slave_sii_image_init(sii_image);
+
+    if (!(sii_image->words = kmalloc(nwords * 2, GFP_KERNEL))) {
+        EC_MASTER_ERR(master, "Failed to allocate %zu words"
+                " of cached SII data.\n", nwords);
+        kfree(sii_image);
+        return -ENOMEM;
+    }
+    memcpy(sii_image->words, words, nwords * 2);
+    sii_image->nwords = nwords;
+    sii_image->loaded = 1;
+
+    sii_image->sii.alias = alias;
+    sii_image->sii.vendor_id = vendor_id;
+    sii_image->sii.product_code = product_code;
+    sii_image->sii.revision_number = revision_number;
+    sii_image->sii.serial_number = serial_number;
+
+    list_add_tail(&sii_image->list, &master->sii_images);
+
+    EC_MASTER_DBG(master, 1, "Added cached SII image of vendor 0x%08x,"
+            " product 0x%08x, revision 0x%08x, serial 0x%08x,"
+            " alias %u (%zu words).\n", vendor_id, product_code,
+            revision_number, serial_number, alias, nwords);
+    return 0;
+}
+
+#endif
+
 /*****************************************************************************/
 
 /** Set flag to say that the slaves are not available for slave request
@@ -601,11 +811,67 @@ void ec_master_slaves_available(ec_master_t *master)
 
 /*****************************************************************************/
 
+/** Sets the slave array and the number of slaves.
+ *
+ * The receive path dispatches mailbox responses to the slaves (see
+ * ec_master_find_slave_by_station_address()) and only holds io_sem, so the
+ * slave array has to be changed under io_sem, too. Slaves have to be
+ * initialized before and may only be cleared after they are removed from
+ * the array this way.
+ */
+void ec_master_set_slaves(
+        ec_master_t *master, /**< EtherCAT master. */
+        ec_slave_t *slaves, /**< Slave array. */
+        unsigned int slave_count /**< Number of slaves. */
+        )
+{
+    ec_lock_down(&master->io_sem);
+    master->slaves = slaves;
+    master->slave_count = slave_count;
+    ec_lock_up(&master->io_sem);
+}
+
+/*****************************************************************************/
+
+/** Removes a slave FSM from the execution list.
+ *
+ * A datagram, that the FSM pushed to the external ring, but that was not
+ * sent yet, is invalidated, so that it is neither injected nor sent on
+ * behalf of a removed slave. The pool datagram becomes free again, because
+ * ec_master_exec_slave_fsms() rebuilds its ownership bitmap from the
+ * execution list. Has to be called with the \a io_sem held.
+ */
+static void ec_master_unlink_slave_fsm(
+        ec_master_t *master, /**< EtherCAT master. */
+        ec_fsm_slave_t *fsm /**< Slave FSM. */
+        )
+{
+    ec_datagram_t *datagram = fsm->datagram;
+
+    list_del_init(&fsm->list);
+    master->fsm_exec_count--;
+
+    if (!datagram) {
+        return;
+    }
+
+    if (datagram->state == EC_DATAGRAM_QUEUED) {
+        list_del_init(&datagram->queue);
+        datagram->state = EC_DATAGRAM_INVALID;
+    } else if (datagram->state == EC_DATAGRAM_INIT) {
+        datagram->state = EC_DATAGRAM_INVALID;
+    }
+}
+
+/*****************************************************************************/
+
 /** Clear all slaves.
  */
 void ec_master_clear_slaves(ec_master_t *master)
 {
-    ec_slave_t *slave;
+    ec_slave_t *slaves = master->slaves, *slave;
+    unsigned int slave_count = master->slave_count;
+    ec_fsm_slave_t *fsm, *next_fsm;
 
     master->dc_ref_clock = NULL;
 
@@ -625,21 +891,111 @@ void ec_master_clear_slaves(ec_master_t *master)
     }
 
     master->fsm_slave = NULL;
-    INIT_LIST_HEAD(&master->fsm_exec_list);
-    master->fsm_exec_count = 0;
 
-    for (slave = master->slaves;
-            slave < master->slaves + master->slave_count;
-            slave++) {
+    ec_lock_down(&master->io_sem);
+    list_for_each_entry_safe(fsm, next_fsm, &master->fsm_exec_list, list) {
+        ec_master_unlink_slave_fsm(master, fsm);
+    }
+    ec_lock_up(&master->io_sem);
+
+    // detach the slaves from the receive path before clearing them
+    ec_master_set_slaves(master, NULL, 0);
+
+    for (slave = slaves; slave < slaves + slave_count; slave++) {
         ec_slave_clear(slave);
     }
 
-    if (master->slaves) {
-        kfree(master->slaves);
-        master->slaves = NULL;
+    if (slaves) {
+        kfree(slaves);
     }
 
-    master->slave_count = 0;
+    master->slave_capacity = 0;
+}
+
+/*****************************************************************************/
+
+/** Remove the slaves at the end of the bus.
+ *
+ * Clears all slaves with a ring position of \a count or higher, while the
+ * remaining slaves keep their state and their attached configurations. The
+ * EoE thread has to be stopped by the caller.
+ */
+void ec_master_remove_slaves(
+        ec_master_t *master, /**< EtherCAT master. */
+        unsigned int count /**< Number of slaves to keep. */
+        )
+{
+    ec_slave_t *first = master->slaves + count, *last, *slave;
+    ec_sii_write_request_t *request, *next_request;
+    unsigned int i;
+    ec_fsm_slave_t *fsm, *next_fsm;
+#ifdef EC_EOE
+    ec_eoe_t *eoe, *next_eoe;
+#endif
+
+    if (count >= master->slave_count) {
+        return;
+    }
+
+    if (master->dc_ref_clock >= first) {
+        master->dc_ref_clock = NULL;
+    }
+
+    list_for_each_entry_safe(request, next_request,
+            &master->sii_requests, list) {
+        if (request->slave < first) {
+            continue;
+        }
+        list_del_init(&request->list); // dequeue
+        EC_MASTER_WARN(master, "Discarding SII request, slave %s-%u about"
+                " to be deleted.\n", ec_device_names[request->slave->device_index!=0],
+                request->slave->ring_position);
+        request->state = EC_INT_REQUEST_FAILURE;
+        wake_up_all(&master->request_queue);
+    }
+
+    ec_lock_down(&master->io_sem);
+    list_for_each_entry_safe(fsm, next_fsm, &master->fsm_exec_list, list) {
+        if (fsm->slave >= first) {
+            ec_master_unlink_slave_fsm(master, fsm);
+        }
+    }
+    ec_lock_up(&master->io_sem);
+
+    if (master->fsm_slave >= first) {
+        master->fsm_slave = master->slaves;
+    }
+
+#ifdef EC_EOE
+    list_for_each_entry_safe(eoe, next_eoe, &master->eoe_handlers, list) {
+        if (!eoe->slave || eoe->slave < first) {
+            continue;
+        }
+        if (eoe->auto_created) {
+            list_del(&eoe->list);
+            ec_eoe_clear(eoe);
+            kfree(eoe);
+        } else {
+            ec_eoe_clear_slave(eoe);
+        }
+    }
+#endif
+
+    for (slave = master->slaves; slave < first; slave++) {
+        for (i = 0; i < EC_MAX_PORTS; i++) {
+            if (slave->ports[i].next_slave >= first) {
+                slave->ports[i].next_slave = NULL;
+            }
+        }
+    }
+
+    // detach the removed slaves from the receive path before clearing them
+    last = master->slaves + master->slave_count;
+    ec_master_set_slaves(master, master->slaves, count);
+
+    for (slave = first; slave < last; slave++) {
+        ec_slave_clear(slave);
+    }
 }
 
 /*****************************************************************************/
@@ -941,15 +1297,18 @@ void ec_master_inject_external_datagrams(
 {
     ec_datagram_t *datagram;
     size_t queue_size = 0, new_queue_size = 0;
+    unsigned int idx_fsm = master->ext_ring_idx_fsm;
 #if DEBUG_INJECT
     unsigned int datagram_count = 0;
 #endif
 
-    if (master->ext_ring_idx_rt == master->ext_ring_idx_fsm) {
+    if (master->ext_ring_idx_rt == idx_fsm) {
         // nothing to inject
         return;
     }
 
+    smp_rmb(); /* read the FSM index before the datagram contents */
+
     list_for_each_entry(datagram, &master->datagram_queue, queue) {
         if (datagram->state == EC_DATAGRAM_QUEUED) {
             queue_size += datagram->data_size;
@@ -961,8 +1320,8 @@ void ec_master_inject_external_datagrams(
             queue_size);
 #endif
 
-    while (master->ext_ring_idx_rt != master->ext_ring_idx_fsm) {
-        datagram = &master->ext_datagram_ring[master->ext_ring_idx_rt];
+    while (master->ext_ring_idx_rt != idx_fsm) {
+        datagram = master->ext_ring[master->ext_ring_idx_rt];
 
         if (datagram->state != EC_DATAGRAM_INIT) {
             // skip datagram
@@ -1073,18 +1432,38 @@ void ec_master_reboot_slaves(
 
 /*****************************************************************************/
 
-/** Searches for a free datagram in the external datagram ring.
+/** Searches for a free datagram in the external datagram pool.
+ *
+ * A datagram is free, if it is neither owned by an executing slave FSM
+ * (marked in \a owned) nor still in the datagram queue. The datagram is
+ * placed at the current position of the external ring, see
+ * ec_master_push_external_datagram().
  *
  * \return Next free datagram, or NULL.
  */
-ec_datagram_t *ec_master_get_external_datagram(
-        ec_master_t *master /**< EtherCAT master */
+static ec_datagram_t *ec_master_get_external_datagram(
+        ec_master_t *master, /**< EtherCAT master */
+        const unsigned long *owned /**< Bitmap of owned pool datagrams. */
         )
 {
-    if ((master->ext_ring_idx_fsm + 1) % EC_EXT_RING_SIZE !=
-            master->ext_ring_idx_rt) {
-        ec_datagram_t *datagram =
-            &master->ext_datagram_ring[master->ext_ring_idx_fsm];
+    unsigned int idx_rt = master->ext_ring_idx_rt, i;
+    ec_datagram_t *datagram;
+
+    smp_rmb(); /* read the RT index before reusing the datagram */
+
+    if ((master->ext_ring_idx_fsm + 1) % EC_EXT_RING_SIZE == idx_rt) {
+        return NULL;
+    }
+
+    for (i = 0; i < EC_EXT_RING_SIZE; i++) {
+        datagram = &master->ext_datagram_ring[i];
+        if (test_bit(i, owned) ||
+                datagram->state == EC_DATAGRAM_QUEUED ||
+                datagram->state == EC_DATAGRAM_SENT) {
+            continue;
+        }
+
+        master->ext_ring[master->ext_ring_idx_fsm] = datagram;
         /* Record the queued time for ec_master_inject_external_datagrams */
 #ifdef EC_HAVE_CYCLES
         datagram->cycles_sent = get_cycles();
@@ -1093,9 +1472,27 @@ ec_datagram_t *ec_master_get_external_datagram(
 
         return datagram;
     }
-    else {
-        return NULL;
-    }
+
+    return NULL;
+}
+
+/*****************************************************************************/
+
+/** Hands the current datagram of the external ring over to the RT side.
+ *
+ * The external datagram ring is a single-producer/single-consumer queue:
+ * Only the FSM side advances \a ext_ring_idx_fsm and only the RT side (see
+ * ec_master_inject_external_datagrams()) advances \a ext_ring_idx_rt, so no
+ * lock is needed, as long as the index is published after the datagram
+ * contents.
+ */
+static inline void ec_master_push_external_datagram(
+        ec_master_t *master /**< EtherCAT master */
+        )
+{
+    smp_wmb(); /* datagram contents before the index */
+    master->ext_ring_idx_fsm =
+        (master->ext_ring_idx_fsm + 1) % EC_EXT_RING_SIZE;
 }
 
 /*****************************************************************************/
@@ -1107,34 +1504,149 @@ void ec_master_queue_datagram(
         ec_datagram_t *datagram /**< datagram */
         )
 {
-    ec_datagram_t *queued_datagram;
-
     /* It is possible, that a datagram in the queue is re-initialized with the
      * ec_datagram_<type>() methods and then shall be queued with this method.
      * In that case, the state is already reset to EC_DATAGRAM_INIT. Check if
      * the datagram is queued to avoid duplicate queuing (which results in an
      * infinite loop!). Set the state to EC_DATAGRAM_QUEUED again, probably
-     * causing an unmatched datagram. */
-    list_for_each_entry(queued_datagram, &master->datagram_queue, queue) {
-        if (queued_datagram == datagram) {
-            datagram->skip_count++;
+     * causing an unmatched datagram.
+     *
+     * The queue item is re-initialized whenever a datagram is dequeued (see
+     * ec_datagram_init() and the list_del_init() calls), so an empty item
+     * means that the datagram is not queued. */
+    if (!list_empty(&datagram->queue)) {
+        datagram->skip_count++;
 #ifdef EC_RT_SYSLOG
-            EC_MASTER_DBG(master, 1,
-                    "Datagram %p already queued (skipping).\n", datagram);
+        EC_MASTER_DBG(master, 1,
+                "Datagram %p already queued (skipping).\n", datagram);
 #endif
-            datagram->state = EC_DATAGRAM_QUEUED;
-            return;
-        }
+        datagram->state = EC_DATAGRAM_QUEUED;
+        return;
     }
 
     if (datagram->state != EC_DATAGRAM_INVALID) {
-        list_add_tail(&datagram->queue, &master->datagram_queue);
+        if (datagram->mbox_status) {
+            // answered by the mailbox status datagram
+            list_add_tail(&datagram->queue, &master->mbox_check_queue);
+        } else {
+            list_add_tail(&datagram->queue, &master->datagram_queue);
+        }
         datagram->state = EC_DATAGRAM_QUEUED;
     }
 }
 
 /*****************************************************************************/
 
+/** Queues the mailbox status datagram for pending mailbox checks.
+ *
+ * Mailbox check datagrams of slaves with a mapped mailbox status (see
+ * ec_slave_mbox_prepare_check()) are not sent themselves. Instead, one LRD
+ * reads the mailbox states of all slaves and answers all checks queued
+ * before, see ec_master_complete_mbox_checks().
+ */
+static void ec_master_queue_mbox_status(
+        ec_master_t *master /**< EtherCAT master */
+        )
+{
+    ec_datagram_t *datagram = &master->mbox_status_datagram, *check;
+    size_t size = 0, offset;
+    unsigned int i;
+
+    if (list_empty(&master->mbox_check_queue)
+            || !list_empty(&master->mbox_check_sent)
+            || datagram->state == EC_DATAGRAM_QUEUED
+            || datagram->state == EC_DATAGRAM_SENT) {
+        // nothing to check, or still waiting for the last status
+        return;
+    }
+
+    list_for_each_entry(check, &master->mbox_check_queue, queue) {
+        offset = check->mbox_status - datagram->data;
+        if (offset >= size) {
+            size = offset + 1;
+        }
+        check->state = EC_DATAGRAM_SENT;
+    }
+    list_splice_init(&master->mbox_check_queue, &master->mbox_check_sent);
+
+    // every mapped slave in the read range increments the working counter
+    master->mbox_status_wc = 0;
+    for (i = 0; i < size && i < master->slave_count; i++) {
+        if (master->slaves[i].mbox_status_mapped) {
+            master->mbox_status_wc++;
+        }
+    }
+
+    ec_datagram_lrd(datagram, EC_MBOX_STATUS_ADDRESS, size);
+    ec_datagram_zero(datagram);
+    ec_master_queue_datagram(master, datagram);
+    master->mbox_status_reads++;
+}
+
+/*****************************************************************************/
+
+/** Answers the mailbox checks with the received mailbox status datagram.
+ *
+ * If not all mapped slaves responded, a slave may have lost its mailbox
+ * status FMMU (for example after falling back to INIT), so the checks are
+ * sent as separate FPRDs instead.
+ */
+static void ec_master_complete_mbox_checks(
+        ec_master_t *master /**< EtherCAT master */
+        )
+{
+    const ec_datagram_t *status = &master->mbox_status_datagram;
+    ec_datagram_t *check, *next;
+    int complete;
+
+    if (list_empty(&master->mbox_check_sent)
+            || status->state == EC_DATAGRAM_QUEUED
+            || status->state == EC_DATAGRAM_SENT) {
+        return;
+    }
+
+    complete = status->state == EC_DATAGRAM_RECEIVED
+        && status->working_counter == master->mbox_status_wc;
+
+    list_for_each_entry_safe(check, next, &master->mbox_check_sent, queue) {
+        list_del_init(&check->queue);
+
+        if (check->state == EC_DATAGRAM_QUEUED) {
+            // queued again while pending, keep it for the next cycle
+            ec_master_queue_datagram(master, check);
+            continue;
+        }
+
+        if (check->state != EC_DATAGRAM_SENT) {
+            // re-initialized while pending
+            continue;
+        }
+
+        if (status->state == EC_DATAGRAM_RECEIVED && !complete) {
+            // check the mailbox with a separate datagram
+            check->mbox_status = NULL;
+            ec_master_queue_datagram(master, check);
+            continue;
+        }
+
+        if (status->state == EC_DATAGRAM_RECEIVED) {
+            ec_datagram_zero(check);
+            EC_WRITE_U8(check->data + 5, *check->mbox_status);
+            check->working_counter = 1;
+            master->mbox_status_checks++;
+        }
+#ifdef EC_HAVE_CYCLES
+        check->cycles_sent = status->cycles_sent;
+        check->cycles_received = status->cycles_received;
+#endif
+        check->jiffies_sent = status->jiffies_sent;
+        check->jiffies_received = status->jiffies_received;
+        check->state = status->state;
+    }
+}
+
+/*****************************************************************************/
+
 /** Places a datagram in the non-application datagram queue.
  */
 void ec_master_queue_datagram_ext(
@@ -1149,13 +1661,46 @@ void ec_master_queue_datagram_ext(
 
 /*****************************************************************************/
 
-static int index_in_use(ec_master_t *master, uint8_t index)
+/** Allocates a datagram index via the master's index table.
+ *
+ * An index is regarded as free, if no datagram is pending with it, so that
+ * ec_master_receive_datagrams() can not confuse a response with another
+ * datagram. The search starts at the current datagram index and usually
+ * terminates at the first entry.
+ *
+ * \return 0 in case of success, else -EBUSY.
+ */
+static int ec_master_alloc_datagram_index(
+        ec_master_t *master, /**< EtherCAT master */
+        ec_datagram_t *datagram /**< Datagram to send. */
+        )
 {
-    ec_datagram_t *datagram;
-    list_for_each_entry(datagram, &master->datagram_queue, queue)
-        if (datagram->state == EC_DATAGRAM_SENT && datagram->index == index)
-            return 1;
-    return 0;
+    ec_datagram_t **entry;
+    unsigned int i;
+
+    // drop stale references to a datagram that was re-initialized while
+    // pending
+    ec_datagram_release(datagram);
+
+    for (i = 0; i < EC_DATAGRAM_INDEX_COUNT; i++) {
+        entry = &master->datagram_table[master->datagram_index];
+
+        if (*entry && (*entry)->state == EC_DATAGRAM_SENT) {
+            master->datagram_index++;
+            continue;
+        }
+
+        if (*entry) { // occupied by a datagram that is not pending any more
+            (*entry)->index_entry = NULL;
+        }
+
+        *entry = datagram;
+        datagram->index_entry = entry;
+        datagram->index = master->datagram_index++;
+        return 0;
+    }
+
+    return -EBUSY;
 }
 
 /** Sends the datagrams in the queue for a certain device.
@@ -1177,7 +1722,6 @@ size_t ec_master_send_datagrams(
     unsigned int frame_count, more_datagrams_waiting;
     struct list_head sent_datagrams;
     size_t sent_bytes = 0;
-    uint8_t last_index;
 
 #ifdef EC_HAVE_CYCLES
     cycles_start = get_cycles();
@@ -1212,19 +1756,26 @@ size_t ec_master_send_datagrams(
                 + EC_DATAGRAM_FOOTER_SIZE;
             if (cur_data - frame_data + datagram_size > ETH_DATA_LEN) {
                 more_datagrams_waiting = 1;
+#ifdef EC_FRAME_PACKING
+                // fill the remaining space with following datagrams, if
+                // at least an empty datagram would still fit. The queue
+                // order is kept, so cyclic datagrams are distributed to
+                // the same frames in every cycle.
+                if (ETH_DATA_LEN - (cur_data - frame_data)
+                        >= EC_DATAGRAM_HEADER_SIZE
+                        + EC_DATAGRAM_FOOTER_SIZE) {
+                    continue;
+                }
+#endif
                 break;
             }
 
             // do not reuse the index of a pending datagram to avoid confusion
             // in ec_master_receive_datagrams()
-            last_index = master->datagram_index;
-            while (index_in_use(master, master->datagram_index)) {
-                if (++master->datagram_index == last_index) {
-                    EC_MASTER_ERR(master, "No free datagram index, sending delayed\n");
-                    goto break_send;
-                }
+            if (ec_master_alloc_datagram_index(master, datagram)) {
+                EC_MASTER_ERR(master, "No free datagram index, sending delayed\n");
+                goto break_send;
             }
-            datagram->index = master->datagram_index++;
 
             list_add_tail(&datagram->sent, &sent_datagrams);
 
@@ -1247,7 +1798,9 @@ size_t ec_master_send_datagrams(
             cur_data += EC_DATAGRAM_HEADER_SIZE;
 
             // EtherCAT datagram data
-            memcpy(cur_data, datagram->data, datagram->data_size);
+            memcpy(cur_data, datagram->send_data ?
+                    datagram->send_data : datagram->data,
+                    datagram->data_size);
             cur_data += datagram->data_size;
 
             // EtherCAT datagram footer
@@ -1264,6 +1817,7 @@ break_send:
         // EtherCAT frame header
         EC_WRITE_U16(frame_data, ((cur_data - frame_data
                         - EC_FRAME_HEADER_SIZE) & 0x7FF) | 0x1000);
+        master->device_stats.cycle_frame_bytes += cur_data - frame_data;
 
         // pad frame
         while (cur_data - frame_data < ETH_ZLEN - ETH_HLEN)
@@ -1289,13 +1843,19 @@ break_send:
 #endif
             datagram->jiffies_sent = jiffies_sent;
             datagram->app_time_sent = master->app_time;
-            list_del_init(&datagram->sent); // empty list of sent datagrams
         }
 
+        // frames are sent in chronological order, so appending keeps the
+        // sent queue ordered by sending time
+        list_splice_tail_init(&sent_datagrams, &master->sent_queue);
+
         frame_count++;
     }
     while (more_datagrams_waiting && frame_count < EC_TX_RING_SIZE);
 
+    master->device_stats.cycle_frames += frame_count;
+    master->device_stats.last_cycle_frames += frame_count;
+
 #ifdef EC_HAVE_CYCLES
     if (unlikely(master->debug_level > 1)) {
         cycles_end = get_cycles();
@@ -1309,6 +1869,79 @@ break_send:
 
 /*****************************************************************************/
 
+/** Finds a slave by its configured station address.
+ *
+ * The master assigns the station addresses itself during the bus scan (see
+ * ec_fsm_master_state_broadcast()): the slave at index i of the slave array
+ * gets the address i + 1. Because the slave array is re-allocated on every
+ * rescan, this mapping is always up to date and the lookup can be done in
+ * constant time in the receive path.
+ *
+ * \return Slave pointer, or NULL, if no slave has the address.
+ */
+static inline ec_slave_t *ec_master_find_slave_by_station_address(
+        ec_master_t *master, /**< EtherCAT master */
+        uint16_t station_address /**< Configured station address. */
+        )
+{
+    ec_slave_t *slave;
+
+    if (unlikely(!station_address || station_address > master->slave_count)) {
+        return NULL;
+    }
+
+    slave = master->slaves + station_address - 1;
+    return likely(slave->station_address == station_address) ? slave : NULL;
+}
+
+/*****************************************************************************/
+
+/** Accounts the round-trip time of a received datagram.
+ *
+ * The time is measured from sending the datagram to polling the device, that
+ * received it, and is accounted to the device, that sent it.
+ */
+static inline void ec_master_record_latency(
+        ec_master_t *master, /**< EtherCAT master */
+        const ec_device_t *device, /**< Receiving device. */
+        const ec_datagram_t *datagram /**< Received datagram. */
+        )
+{
+    ec_latency_stats_t *stats;
+    u64 ns;
+    u32 ns32;
+    unsigned int bin;
+
+    if (unlikely(datagram->device_index >= EC_MAX_NUM_DEVICES
+                || datagram->traffic_class >= EC_DATAGRAM_CLASS_COUNT)) {
+        return;
+    }
+
+#ifdef EC_HAVE_CYCLES
+    ns = (u64) (device->cycles_poll - datagram->cycles_sent) * 1000000;
+    do_div(ns, cpu_khz);
+#else
+    ns = (u64) (device->jiffies_poll - datagram->jiffies_sent)
+        * (1000000000 / HZ);
+#endif
+    ns32 = ns > 0xffffffff ? 0xffffffff : (u32) ns;
+    bin = ns32 ? fls(ns32) - 1 : 0;
+
+    stats = &master->latency_stats[datagram->device_index]
+        [datagram->traffic_class];
+    if (!stats->count || ns32 < stats->min_ns) {
+        stats->min_ns = ns32;
+    }
+    if (ns32 > stats->max_ns) {
+        stats->max_ns = ns32;
+    }
+    stats->sum_ns += ns32;
+    stats->bins[bin]++;
+    stats->count++;
+}
+
+/*****************************************************************************/
+
 /** Processes a received frame.
  *
  * This function is called by the network driver for every received frame.
@@ -1393,17 +2026,12 @@ void ec_master_receive_datagrams(
             return;
         }
 
-        // search for matching datagram in the queue
-        matched = 0;
-        list_for_each_entry(datagram, &master->datagram_queue, queue) {
-            if (datagram->index == datagram_index
-                && datagram->state == EC_DATAGRAM_SENT
-                && datagram->type == datagram_type
-                && datagram->data_size == data_size) {
-                matched = 1;
-                break;
-            }
-        }
+        // look up the matching datagram in the index table
+        datagram = master->datagram_table[datagram_index];
+        matched = datagram
+            && datagram->state == EC_DATAGRAM_SENT
+            && datagram->type == datagram_type
+            && datagram->data_size == data_size;
 
         // no matching datagram was found
         if (!matched) {
@@ -1436,12 +2064,9 @@ void ec_master_receive_datagrams(
                 datagram_wc = EC_READ_U16(cur_data + data_size);
                 if (datagram_wc) {
                     if (master->slaves != NULL) {
-                        for (slave = master->slaves; slave < master->slaves + master->slave_count; slave++) {
-                            if (slave->station_address == datagram_slave_addr) {
-                                break;
-                            }
-                        }
-                        if (slave->station_address == datagram_slave_addr) {
+                        slave = ec_master_find_slave_by_station_address(
+                                master, datagram_slave_addr);
+                        if (slave) {
                             if (slave->configured_tx_mailbox_offset != 0) {
                                 if (datagram_offset_addr == slave->configured_tx_mailbox_offset) {
                                     if (slave->valid_mbox_data) {
@@ -1555,89 +2180,453 @@ void ec_master_receive_datagrams(
         }
         cur_data += data_size;
 
-        // set the datagram's working counter
-        datagram->working_counter = EC_READ_U16(cur_data);
-        cur_data += EC_DATAGRAM_FOOTER_SIZE;
+        // set the datagram's working counter
+        datagram->working_counter = EC_READ_U16(cur_data);
+        cur_data += EC_DATAGRAM_FOOTER_SIZE;
+
+#ifdef EC_HAVE_CYCLES
+        datagram->cycles_received =
+            master->devices[EC_DEVICE_MAIN].cycles_poll;
+#endif
+        datagram->jiffies_received =
+            master->devices[EC_DEVICE_MAIN].jiffies_poll;
+
+        ec_master_record_latency(master, device, datagram);
+
+        smp_wmb(); /* data must be visible before the state */
+
+        // dequeue the received datagram
+        datagram->state = EC_DATAGRAM_RECEIVED;
+        list_del_init(&datagram->queue);
+        ec_datagram_release(datagram);
+    }
+}
+
+/*****************************************************************************/
+
+/** Output master statistics.
+ *
+ * This function outputs statistical data on demand, but not more often than
+ * necessary. The output happens at most once a second.
+ */
+void ec_master_output_stats(ec_master_t *master /**< EtherCAT master */)
+{
+    if (unlikely(jiffies - master->stats.output_jiffies >= HZ)) {
+        if (!master->scan_busy || (master->debug_level > 0)) {
+            master->stats.output_jiffies = jiffies;
+            if (master->stats.timeouts) {
+                EC_MASTER_WARN(master, "%u datagram%s TIMED OUT!\n",
+                        master->stats.timeouts,
+                        master->stats.timeouts == 1 ? "" : "s");
+                master->stats.timeouts = 0;
+            }
+            if (master->stats.corrupted) {
+                EC_MASTER_WARN(master, "%u frame%s CORRUPTED!\n",
+                        master->stats.corrupted,
+                        master->stats.corrupted == 1 ? "" : "s");
+                master->stats.corrupted = 0;
+            }
+            if (master->stats.unmatched) {
+                EC_MASTER_WARN(master, "%u datagram%s UNMATCHED!\n",
+                        master->stats.unmatched,
+                        master->stats.unmatched == 1 ? "" : "s");
+                master->stats.unmatched = 0;
+            }
+        }
+    }
+}
+
+/*****************************************************************************/
+
+/** Clears the common device statistics.
+ */
+void ec_master_clear_device_stats(
+        ec_master_t *master /**< EtherCAT master */
+        )
+{
+    unsigned int i;
+
+    // zero frame statistics
+    master->device_stats.tx_count = 0;
+    master->device_stats.last_tx_count = 0;
+    master->device_stats.rx_count = 0;
+    master->device_stats.last_rx_count = 0;
+    master->device_stats.tx_bytes = 0;
+    master->device_stats.last_tx_bytes = 0;
+    master->device_stats.rx_bytes = 0;
+    master->device_stats.last_rx_bytes = 0;
+    master->device_stats.last_loss = 0;
+    master->device_stats.cycle_count = 0;
+    master->device_stats.cycle_frames = 0;
+    master->device_stats.cycle_frame_bytes = 0;
+    master->device_stats.last_cycle_frames = 0;
+
+    for (i = 0; i < EC_RATE_COUNT; i++) {
+        master->device_stats.tx_frame_rates[i] = 0;
+        master->device_stats.rx_frame_rates[i] = 0;
+        master->device_stats.tx_byte_rates[i] = 0;
+        master->device_stats.rx_byte_rates[i] = 0;
+        master->device_stats.loss_rates[i] = 0;
+    }
+
+    master->device_stats.jiffies = 0;
+}
+
+/*****************************************************************************/
+
+/** Clears the datagram latency statistics.
+ */
+void ec_master_clear_latency_stats(
+        ec_master_t *master /**< EtherCAT master */
+        )
+{
+    memset(master->latency_stats, 0x00, sizeof(master->latency_stats));
+}
+
+/*****************************************************************************/
+
+/** Allocates the status page for the OPERATION phase.
+ *
+ * The page is sized for the domains and slave configurations existing at
+ * activation time and filled with the current states.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static int ec_master_status_alloc(
+        ec_master_t *master /**< EtherCAT master */
+        )
+{
+    unsigned int domain_count = ec_master_domain_count(master),
+                 config_count = ec_master_config_count(master);
+    ec_ioctl_status_t *status;
+    size_t size;
+
+    size = sizeof(ec_ioctl_status_t)
+        + domain_count * sizeof(ec_ioctl_status_domain_t)
+        + config_count * sizeof(ec_slave_config_state_t);
+    size = PAGE_ALIGN(size);
+
+    status = vmalloc(size);
+    if (!status) {
+        EC_MASTER_ERR(master, "Failed to allocate %zu bytes"
+                " of status memory!\n", size);
+        return -ENOMEM;
+    }
+
+    memset(status, 0x00, size);
+    status->domain_count = domain_count;
+    status->config_count = config_count;
+    status->device_count = ec_master_num_devices(master);
+
+    master->status = status;
+    master->status_size = size;
+
+    ec_master_status_update(master);
+    return 0;
+}
+
+/*****************************************************************************/
+
+/** Frees the status page.
+ */
+static void ec_master_status_free(
+        ec_master_t *master /**< EtherCAT master */
+        )
+{
+    if (master->status) {
+        vfree(master->status);
+        master->status = NULL;
+        master->status_size = 0;
+    }
+}
+
+/*****************************************************************************/
+
+/** Updates the master, link and slave configuration states in the status
+ * page.
+ *
+ * Called by the operation thread with the master_sem held.
+ */
+void ec_master_status_update(
+        ec_master_t *master /**< EtherCAT master */
+        )
+{
+    ec_ioctl_status_t *status = master->status;
+    ec_slave_config_state_t *config_states;
+    const ec_slave_config_t *sc;
+    unsigned int dev_idx, i = 0;
+
+    if (!status) {
+        return;
+    }
+
+    status->sequence++;
+    smp_wmb(); /* sequence before the contents */
+
+    ecrt_master_state(master, &status->master_state);
+    for (dev_idx = EC_DEVICE_MAIN; dev_idx < status->device_count;
+            dev_idx++) {
+        ecrt_master_link_state(master, dev_idx,
+                &status->link_states[dev_idx]);
+    }
+
+    config_states = EC_IOCTL_STATUS_CONFIGS(status);
+    list_for_each_entry(sc, &master->configs, list) {
+        if (i >= status->config_count) {
+            break;
+        }
+        ecrt_slave_config_state(sc, &config_states[i++]);
+    }
+
+    smp_wmb(); /* contents before the sequence */
+    status->sequence++;
+}
+
+/*****************************************************************************/
+
+/** Updates the state of a domain in the status page.
+ *
+ * Called from ecrt_domain_process(). Every domain entry has its own sequence
+ * number, so domains may be processed from different contexts.
+ */
+void ec_master_status_update_domain(
+        ec_master_t *master, /**< EtherCAT master */
+        const ec_domain_t *domain /**< Processed domain. */
+        )
+{
+    ec_ioctl_status_domain_t *entry;
 
-#ifdef EC_HAVE_CYCLES
-        datagram->cycles_received =
-            master->devices[EC_DEVICE_MAIN].cycles_poll;
+    if (!master->status || domain->index >= master->status->domain_count) {
+        return;
+    }
+
+    entry = EC_IOCTL_STATUS_DOMAINS(master->status) + domain->index;
+
+    entry->sequence++;
+    smp_wmb(); /* sequence before the contents */
+    ecrt_domain_state(domain, &entry->state);
+    smp_wmb(); /* contents before the sequence */
+    entry->sequence++;
+}
+
+/*****************************************************************************/
+
+/** Signals master events.
+ *
+ * Wakes up the processes polling on the character device and signals the
+ * bound eventfds. Must not be called from realtime context, use
+ * ec_master_post_event() there.
+ */
+void ec_master_signal_event(
+        ec_master_t *master, /**< EtherCAT master */
+        uint32_t events /**< Bitwise OR of \a EC_EVENT_* values. */
+        )
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 31)
+    ec_event_binding_t *binding;
 #endif
-        datagram->jiffies_received =
-            master->devices[EC_DEVICE_MAIN].jiffies_poll;
+    unsigned long flags;
+    unsigned int i;
 
-        barrier(); /* reordering might lead to races */
+    spin_lock_irqsave(&master->event_lock, flags);
 
-        // dequeue the received datagram
-        datagram->state = EC_DATAGRAM_RECEIVED;
-        list_del_init(&datagram->queue);
+    for (i = 0; i < EC_EVENT_COUNT; i++) {
+        if (events & (1 << i)) {
+            master->event_counts[i]++;
+        }
+    }
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 31)
+    list_for_each_entry(binding, &master->event_bindings, list) {
+        if (binding->events & events) {
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 8, 0)
+            eventfd_signal(binding->eventfd);
+#else
+            eventfd_signal(binding->eventfd, 1);
+#endif
+        }
     }
+#endif
+
+    spin_unlock_irqrestore(&master->event_lock, flags);
+
+    wake_up_interruptible(&master->event_queue);
 }
 
 /*****************************************************************************/
 
-/** Output master statistics.
+/** Posts master events from realtime context.
  *
- * This function outputs statistical data on demand, but not more often than
- * necessary. The output happens at most once a second.
+ * Only marks the events as pending. They are signalled by the next call of
+ * ec_master_flush_events() from the master thread.
  */
-void ec_master_output_stats(ec_master_t *master /**< EtherCAT master */)
+void ec_master_post_event(
+        ec_master_t *master, /**< EtherCAT master */
+        uint32_t events /**< Bitwise OR of \a EC_EVENT_* values. */
+        )
 {
-    if (unlikely(jiffies - master->stats.output_jiffies >= HZ)) {
-        if (!master->scan_busy || (master->debug_level > 0)) {
-            master->stats.output_jiffies = jiffies;
-            if (master->stats.timeouts) {
-                EC_MASTER_WARN(master, "%u datagram%s TIMED OUT!\n",
-                        master->stats.timeouts,
-                        master->stats.timeouts == 1 ? "" : "s");
-                master->stats.timeouts = 0;
-            }
-            if (master->stats.corrupted) {
-                EC_MASTER_WARN(master, "%u frame%s CORRUPTED!\n",
-                        master->stats.corrupted,
-                        master->stats.corrupted == 1 ? "" : "s");
-                master->stats.corrupted = 0;
-            }
-            if (master->stats.unmatched) {
-                EC_MASTER_WARN(master, "%u datagram%s UNMATCHED!\n",
-                        master->stats.unmatched,
-                        master->stats.unmatched == 1 ? "" : "s");
-                master->stats.unmatched = 0;
-            }
+    unsigned int i;
+
+    for (i = 0; i < EC_EVENT_COUNT; i++) {
+        if (events & (1 << i)) {
+            set_bit(i, &master->events_posted);
         }
     }
 }
 
 /*****************************************************************************/
 
-/** Clears the common device statistics.
+/** Signals the events posted with ec_master_post_event().
+ *
+ * Called from the master thread.
  */
-void ec_master_clear_device_stats(
+void ec_master_flush_events(
         ec_master_t *master /**< EtherCAT master */
         )
 {
+    unsigned long events = xchg(&master->events_posted, 0);
+
+    if (events) {
+        ec_master_signal_event(master, events);
+    }
+}
+
+/*****************************************************************************/
+
+/** Gets the events signalled since the last acknowledge.
+ *
+ * \return Bitwise OR of the pending and selected \a EC_EVENT_* values.
+ */
+uint32_t ec_master_pending_events(
+        ec_master_t *master, /**< EtherCAT master */
+        const unsigned int *acks, /**< Event counters at the last
+                                    acknowledge. */
+        uint32_t events /**< Selected events. */
+        )
+{
+    uint32_t pending = 0;
+    unsigned long flags;
     unsigned int i;
 
-    // zero frame statistics
-    master->device_stats.tx_count = 0;
-    master->device_stats.last_tx_count = 0;
-    master->device_stats.rx_count = 0;
-    master->device_stats.last_rx_count = 0;
-    master->device_stats.tx_bytes = 0;
-    master->device_stats.last_tx_bytes = 0;
-    master->device_stats.rx_bytes = 0;
-    master->device_stats.last_rx_bytes = 0;
-    master->device_stats.last_loss = 0;
+    spin_lock_irqsave(&master->event_lock, flags);
+    for (i = 0; i < EC_EVENT_COUNT; i++) {
+        if (master->event_counts[i] != acks[i]) {
+            pending |= 1 << i;
+        }
+    }
+    spin_unlock_irqrestore(&master->event_lock, flags);
 
-    for (i = 0; i < EC_RATE_COUNT; i++) {
-        master->device_stats.tx_frame_rates[i] = 0;
-        master->device_stats.rx_frame_rates[i] = 0;
-        master->device_stats.tx_byte_rates[i] = 0;
-        master->device_stats.rx_byte_rates[i] = 0;
-        master->device_stats.loss_rates[i] = 0;
+    return pending & events;
+}
+
+/*****************************************************************************/
+
+/** Gets and acknowledges the events signalled since the last acknowledge.
+ *
+ * \return Bitwise OR of the pending and selected \a EC_EVENT_* values.
+ */
+uint32_t ec_master_fetch_events(
+        ec_master_t *master, /**< EtherCAT master */
+        unsigned int *acks, /**< Event counters at the last acknowledge
+                              (updated). */
+        uint32_t events /**< Selected events. */
+        )
+{
+    uint32_t pending = 0;
+    unsigned long flags;
+    unsigned int i;
+
+    spin_lock_irqsave(&master->event_lock, flags);
+    for (i = 0; i < EC_EVENT_COUNT; i++) {
+        if (master->event_counts[i] != acks[i]) {
+            pending |= 1 << i;
+            acks[i] = master->event_counts[i];
+        }
     }
+    spin_unlock_irqrestore(&master->event_lock, flags);
 
-    master->device_stats.jiffies = 0;
+    return pending & events;
+}
+
+/*****************************************************************************/
+
+/** Initializes an unbound eventfd binding.
+ */
+void ec_master_init_event_binding(
+        ec_event_binding_t *binding /**< eventfd binding. */
+        )
+{
+    INIT_LIST_HEAD(&binding->list);
+    binding->eventfd = NULL;
+    binding->events = 0;
+}
+
+/*****************************************************************************/
+
+/** Binds events to an eventfd.
+ *
+ * A previous binding is released.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+int ec_master_bind_eventfd(
+        ec_master_t *master, /**< EtherCAT master */
+        ec_event_binding_t *binding, /**< eventfd binding. */
+        int fd, /**< eventfd file descriptor, or -1 to unbind. */
+        uint32_t events /**< Bitwise OR of \a EC_EVENT_* values. */
+        )
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 31)
+    struct eventfd_ctx *eventfd = NULL;
+    unsigned long flags;
+
+    if (fd >= 0) {
+        eventfd = eventfd_ctx_fdget(fd);
+        if (IS_ERR(eventfd)) {
+            return PTR_ERR(eventfd);
+        }
+    }
+
+    ec_master_unbind_eventfd(master, binding);
+
+    if (eventfd) {
+        binding->eventfd = eventfd;
+        binding->events = events;
+
+        spin_lock_irqsave(&master->event_lock, flags);
+        list_add_tail(&binding->list, &master->event_bindings);
+        spin_unlock_irqrestore(&master->event_lock, flags);
+    }
+
+    return 0;
+#else
+    return fd >= 0 ? -EOPNOTSUPP : 0;
+#endif
+}
+
+/*****************************************************************************/
+
+/** Releases an eventfd binding.
+ */
+void ec_master_unbind_eventfd(
+        ec_master_t *master, /**< EtherCAT master */
+        ec_event_binding_t *binding /**< eventfd binding. */
+        )
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 31)
+    unsigned long flags;
+
+    if (!binding->eventfd) {
+        return;
+    }
+
+    spin_lock_irqsave(&master->event_lock, flags);
+    list_del_init(&binding->list);
+    spin_unlock_irqrestore(&master->event_lock, flags);
+
+    eventfd_ctx_put(binding->eventfd);
+    binding->eventfd = NULL;
+#endif
 }
 
 /*****************************************************************************/
@@ -1783,15 +2772,76 @@ static inline void set_normal_priority(struct task_struct *p, int nice)
 
 /*****************************************************************************/
 
+/** Marks the pool datagram used by a slave FSM in a bitmap.
+ */
+static inline void ec_master_mark_external_datagram(
+        ec_master_t *master, /**< EtherCAT master. */
+        const ec_datagram_t *datagram, /**< Pool datagram, or NULL. */
+        unsigned long *owned, /**< Bitmap of owned pool datagrams. */
+        int set /**< Non-zero to mark as owned, zero to release. */
+        )
+{
+    unsigned int i;
+
+    if (!datagram) {
+        return;
+    }
+
+    i = datagram - master->ext_datagram_ring;
+    if (set) {
+        __set_bit(i, owned);
+    } else {
+        __clear_bit(i, owned);
+    }
+}
+
+/*****************************************************************************/
+
+/** Returns the number of external datagram bytes waiting for injection.
+ */
+static size_t ec_master_external_queue_size(
+        const ec_master_t *master /**< EtherCAT master. */
+        )
+{
+    unsigned int idx = master->ext_ring_idx_rt;
+    size_t size = 0;
+
+    while (idx != master->ext_ring_idx_fsm) {
+        const ec_datagram_t *datagram = master->ext_ring[idx];
+        if (datagram->state == EC_DATAGRAM_INIT) {
+            size += datagram->data_size;
+        }
+        idx = (idx + 1) % EC_EXT_RING_SIZE;
+    }
+
+    return size;
+}
+
+/*****************************************************************************/
+
 /** Execute slave FSMs.
+ *
+ * Every slave FSM on the execution list owns the datagram it used last.
+ * FSMs, whose datagram is still on its way, are skipped, so that a slow
+ * slave does not hold back the others. New FSMs are admitted, as long as
+ * the external datagrams waiting for injection fit into the bandwidth of
+ * one send interval (\a max_queue_size) and the datagram pool is not
+ * exhausted.
  */
 void ec_master_exec_slave_fsms(
         ec_master_t *master /**< EtherCAT master. */
         )
 {
-    ec_datagram_t *datagram;
+    ec_datagram_t *datagram, *previous;
     ec_fsm_slave_t *fsm, *next;
+    unsigned long owned[BITS_TO_LONGS(EC_EXT_RING_SIZE)];
     unsigned int count = 0;
+    size_t queue_size;
+
+    bitmap_zero(owned, EC_EXT_RING_SIZE);
+    list_for_each_entry(fsm, &master->fsm_exec_list, list) {
+        ec_master_mark_external_datagram(master, fsm->datagram, owned, 1);
+    }
 
     list_for_each_entry_safe(fsm, next, &master->fsm_exec_list, list) {
         if (!fsm->datagram) {
@@ -1800,23 +2850,21 @@ void ec_master_exec_slave_fsms(
                     fsm->slave->ring_position);
             list_del_init(&fsm->list);
             master->fsm_exec_count--;
-            return;
+            continue;
         }
 
         if (fsm->datagram->state == EC_DATAGRAM_INIT ||
                 fsm->datagram->state == EC_DATAGRAM_QUEUED ||
                 fsm->datagram->state == EC_DATAGRAM_SENT) {
             // previous datagram was not sent or received yet.
-            // wait until next thread execution
-            return;
+            // skip this FSM until the next thread execution
+            continue;
         }
 
-        datagram = ec_master_get_external_datagram(master);
+        datagram = ec_master_get_external_datagram(master, owned);
         if (!datagram) {
-            // no free datagrams at the moment
-            EC_MASTER_WARN(master, "No free datagram during"
-                    " slave FSM execution. This is a bug!\n");
-            continue;
+            // no free datagrams at the moment, try again in the next cycle
+            break;
         }
 
 #if DEBUG_INJECT
@@ -1824,19 +2872,22 @@ void ec_master_exec_slave_fsms(
                 ec_device_names[fsm->slave->device_index!=0],
                 fsm->slave->ring_position);
 #endif
+        previous = fsm->datagram;
         if (ec_fsm_slave_exec(fsm, datagram)) {
+            ec_master_mark_external_datagram(master, previous, owned, 0);
+            ec_master_mark_external_datagram(master, datagram, owned, 1);
             if (datagram->state != EC_DATAGRAM_INVALID) {
                 // FSM consumed datagram
 #if DEBUG_INJECT
                 EC_MASTER_DBG(master, 1, "FSM consumed datagram %s\n",
                         datagram->name);
 #endif
-                master->ext_ring_idx_fsm =
-                    (master->ext_ring_idx_fsm + 1) % EC_EXT_RING_SIZE;
+                ec_master_push_external_datagram(master);
             }
         }
         else {
             // FSM finished
+            ec_master_mark_external_datagram(master, previous, owned, 0);
             list_del_init(&fsm->list);
             master->fsm_exec_count--;
 #if DEBUG_INJECT
@@ -1846,16 +2897,23 @@ void ec_master_exec_slave_fsms(
         }
     }
 
-    while (master->fsm_exec_count < EC_EXT_RING_SIZE / 2
+    queue_size = ec_master_external_queue_size(master);
+
+    while (queue_size < master->max_queue_size
             && count < master->slave_count) {
 
         if (ec_fsm_slave_is_ready(&master->fsm_slave->fsm)) {
-            datagram = ec_master_get_external_datagram(master);
+            datagram = ec_master_get_external_datagram(master, owned);
+            if (!datagram) {
+                // datagram pool exhausted
+                break;
+            }
 
             if (ec_fsm_slave_exec(&master->fsm_slave->fsm, datagram)) {
+                ec_master_mark_external_datagram(master, datagram, owned, 1);
                 if (datagram->state != EC_DATAGRAM_INVALID) {
-                    master->ext_ring_idx_fsm =
-                        (master->ext_ring_idx_fsm + 1) % EC_EXT_RING_SIZE;
+                    ec_master_push_external_datagram(master);
+                    queue_size += datagram->data_size;
                 }
                 list_add_tail(&master->fsm_slave->fsm.list,
                         &master->fsm_exec_list);
@@ -1915,6 +2973,8 @@ static int ec_master_idle_thread(void *priv_data)
 
         ec_lock_up(&master->master_sem);
 
+        ec_master_flush_events(master);
+
         // queue and send
         ec_lock_down(&master->io_sem);
         if (fsm_exec) {
@@ -1961,6 +3021,8 @@ static int ec_master_operation_thread(void *priv_data)
         ec_datagram_output_stats(&master->fsm_datagram);
 
         if (master->injection_seq_rt == master->injection_seq_fsm) {
+            smp_rmb(); /* RT side has queued the FSM datagram */
+
             // output statistics
             ec_master_output_stats(master);
 
@@ -1969,9 +3031,12 @@ static int ec_master_operation_thread(void *priv_data)
                 break;
             }
 
+            ec_request_ring_submit(&master->request_ring);
+
             if (ec_fsm_master_exec(&master->fsm)) {
                 // Inject datagrams (let the RT thread queue them, see
                 // ecrt_master_send())
+                smp_wmb(); /* datagram contents before the sequence */
                 master->injection_seq_fsm++;
             }
 
@@ -1982,9 +3047,15 @@ static int ec_master_operation_thread(void *priv_data)
                 ec_master_exec_slave_fsms(master);
             }
 
+            ec_request_ring_publish(&master->request_ring);
+            ec_master_status_update(master);
+
             ec_lock_up(&master->master_sem);
         }
 
+        // signal the events posted by the realtime context, too
+        ec_master_flush_events(master);
+
 #ifdef EC_USE_HRTIMER
         // the op thread should not work faster than the sending RT thread
         ec_master_nanosleep(master->send_interval * 1000);
@@ -2703,6 +3774,18 @@ void ec_master_request_op(
         ec_slave_request_state(master->dc_ref_clock, EC_SLAVE_STATE_OP);
     }
 #endif
+
+    /* A broadcast write to the AL control register reaches every slave, so
+     * the transition to OP can only be grouped, if all slaves shall be in
+     * OP. */
+    master->group_op = group_transitions && master->slave_count > 1;
+    for (i = 0; i < master->slave_count && master->group_op; i++) {
+        if (master->slaves[i].requested_state != EC_SLAVE_STATE_OP) {
+            EC_MASTER_DBG(master, 1, "Slave %u is not requested to go to OP."
+                    " Changing states individually.\n", i);
+            master->group_op = 0;
+        }
+    }
 }
 
 /*****************************************************************************/
@@ -2852,6 +3935,13 @@ int ecrt_master_activate(ec_master_t *master)
         domain_offset += domain->data_size;
     }
 
+    ec_master_status_free(master);
+    ret = ec_master_status_alloc(master);
+    if (ret < 0) {
+        ec_lock_up(&master->master_sem);
+        return ret;
+    }
+
     ec_lock_up(&master->master_sem);
 
     // restart EoE process and master thread with new locking
@@ -2887,6 +3977,10 @@ int ecrt_master_activate(ec_master_t *master)
     master->allow_scan = 1;
 
     master->active = 1;
+    master->activate_jiffies = jiffies;
+    master->op_pending = 1;
+    master->op_duration = 0;
+    master->op_grouped = 0;
 
     // notify state machine, that the configuration shall now be applied
     master->config_changed = 1;
@@ -2909,6 +4003,8 @@ void ecrt_master_deactivate_slaves(ec_master_t *master)
         return;
     }
 
+    master->op_pending = 0;
+    master->group_op = 0;
 
     // clear dc settings on all slaves
     list_for_each_entry_safe(sc, next, &master->configs, list) {
@@ -2955,6 +4051,8 @@ void ecrt_master_deactivate(ec_master_t *master)
     master->receive_cb = ec_master_internal_receive_cb;
     master->cb_data = master;
 
+    ec_master_status_free(master);
+    ec_request_ring_free(&master->request_ring);
     ec_master_clear_config(master);
 
     for (slave = master->slaves;
@@ -2982,6 +4080,8 @@ void ecrt_master_deactivate(ec_master_t *master)
     master->allow_scan = 0;
 
     master->active = 0;
+    master->op_pending = 0;
+    master->group_op = 0;
 
 #ifdef EC_EOE
     ec_master_eoe_start(master);
@@ -2999,15 +4099,21 @@ size_t ecrt_master_send(ec_master_t *master)
     ec_datagram_t *datagram, *n;
     ec_device_index_t dev_idx;
     size_t sent_bytes = 0;
+    unsigned int injection_seq_fsm = master->injection_seq_fsm;
 
+    if (master->injection_seq_rt != injection_seq_fsm) {
+        smp_rmb(); /* read the sequence before the datagram contents */
 
-    if (master->injection_seq_rt != master->injection_seq_fsm) {
         // inject datagram produced by master FSM
         ec_master_queue_datagram(master, &master->fsm_datagram);
-        master->injection_seq_rt = master->injection_seq_fsm;
+        smp_wmb(); /* queue the datagram before releasing it */
+        master->injection_seq_rt = injection_seq_fsm;
     }
 
     ec_master_inject_external_datagrams(master);
+    ec_master_queue_mbox_status(master);
+
+    master->device_stats.last_cycle_frames = 0;
 
     for (dev_idx = EC_DEVICE_MAIN; dev_idx < ec_master_num_devices(master);
             dev_idx++) {
@@ -3018,6 +4124,7 @@ size_t ecrt_master_send(ec_master_t *master)
                 if (datagram->device_index == dev_idx) {
                     datagram->state = EC_DATAGRAM_ERROR;
                     list_del_init(&datagram->queue);
+                    ec_datagram_release(datagram);
                 }
             }
 
@@ -3038,6 +4145,10 @@ size_t ecrt_master_send(ec_master_t *master)
             ec_master_send_datagrams(master, dev_idx));
     }
 
+    if (master->device_stats.last_cycle_frames) {
+        master->device_stats.cycle_count++;
+    }
+
     return sent_bytes;
 }
 
@@ -3055,42 +4166,56 @@ void ecrt_master_receive(ec_master_t *master)
     }
     ec_master_update_device_stats(master);
 
-    // dequeue all datagrams that timed out
-    list_for_each_entry_safe(datagram, next, &master->datagram_queue, queue) {
-        if (datagram->state != EC_DATAGRAM_SENT) continue;
+    // dequeue all datagrams that timed out. The sent queue is ordered by
+    // sending time, so the check ends at the first datagram that did not
+    // time out.
+    master->stats.last_cycle_timeouts = 0;
+    list_for_each_entry_safe(datagram, next, &master->sent_queue, sent) {
+        if (datagram->state != EC_DATAGRAM_SENT) {
+            // re-initialized while pending
+            list_del_init(&datagram->sent);
+            continue;
+        }
 
 #ifdef EC_HAVE_CYCLES
         if (master->devices[EC_DEVICE_MAIN].cycles_poll -
-                datagram->cycles_sent > timeout_cycles) {
+                datagram->cycles_sent <= timeout_cycles) {
 #else
         if (master->devices[EC_DEVICE_MAIN].jiffies_poll -
-                datagram->jiffies_sent > timeout_jiffies) {
+                datagram->jiffies_sent <= timeout_jiffies) {
 #endif
-            list_del_init(&datagram->queue);
-            datagram->state = EC_DATAGRAM_TIMED_OUT;
-            master->stats.timeouts++;
+            break;
+        }
+
+        list_del_init(&datagram->queue);
+        ec_datagram_release(datagram);
+        datagram->state = EC_DATAGRAM_TIMED_OUT;
+        master->stats.timeouts++;
+        master->stats.last_cycle_timeouts++;
+        master->stats.total_timeouts++;
 
 #ifdef EC_RT_SYSLOG
-            ec_master_output_stats(master);
+        ec_master_output_stats(master);
 
-            if (unlikely(master->debug_level > 0)) {
-                unsigned int time_us;
+        if (unlikely(master->debug_level > 0)) {
+            unsigned int time_us;
 #ifdef EC_HAVE_CYCLES
-                time_us = (unsigned int)
-                    (master->devices[EC_DEVICE_MAIN].cycles_poll -
-                        datagram->cycles_sent) * 1000 / cpu_khz;
+            time_us = (unsigned int)
+                (master->devices[EC_DEVICE_MAIN].cycles_poll -
+                    datagram->cycles_sent) * 1000 / cpu_khz;
 #else
-                time_us = (unsigned int)
-                    ((master->devices[EC_DEVICE_MAIN].jiffies_poll -
-                            datagram->jiffies_sent) * 1000000 / HZ);
+            time_us = (unsigned int)
+                ((master->devices[EC_DEVICE_MAIN].jiffies_poll -
+                        datagram->jiffies_sent) * 1000000 / HZ);
 #endif
-                EC_MASTER_DBG(master, 0, "TIMED OUT datagram %p,"
-                        " index %02X waited %u us.\n",
-                        datagram, datagram->index, time_us);
-            }
-#endif /* RT_SYSLOG */
+            EC_MASTER_DBG(master, 0, "TIMED OUT datagram %p,"
+                    " index %02X waited %u us.\n",
+                    datagram, datagram->index, time_us);
         }
+#endif /* RT_SYSLOG */
     }
+
+    ec_master_complete_mbox_checks(master);
 }
 
 /*****************************************************************************/
@@ -3103,7 +4228,7 @@ size_t ecrt_master_send_ext(ec_master_t *master)
 
     list_for_each_entry_safe(datagram, next, &master->ext_datagram_queue,
             queue) {
-        list_del(&datagram->queue);
+        list_del_init(&datagram->queue);
         ec_master_queue_datagram(master, datagram);
     }
     ec_lock_up(&master->ext_queue_sem);
@@ -3467,6 +4592,57 @@ uint32_t ecrt_master_sync_monitor_process(ec_master_t *master)
 
 /*****************************************************************************/
 
+int ecrt_master_cycle(ec_master_t *master, ec_cycle_t *cycle)
+{
+    unsigned int i;
+
+    if (cycle->operations & ~EC_IOCTL_CYCLE_OPERATIONS) {
+        return -EINVAL;
+    }
+
+    if (cycle->operations & EC_CYCLE_RECEIVE) {
+        ecrt_master_receive(master);
+    }
+
+    if (cycle->operations & EC_CYCLE_PROCESS) {
+        for (i = 0; i < cycle->domain_count; i++) {
+            ecrt_domain_process(cycle->domains[i].domain);
+            ecrt_domain_state(cycle->domains[i].domain,
+                    &cycle->domains[i].state);
+        }
+    }
+
+    if (cycle->operations & EC_CYCLE_APP_TIME) {
+        ecrt_master_application_time(master, cycle->app_time);
+    }
+    if (cycle->operations & EC_CYCLE_SYNC_REF) {
+        ecrt_master_sync_reference_clock(master);
+    }
+    if (cycle->operations & EC_CYCLE_SYNC_REF_TO) {
+        ecrt_master_sync_reference_clock_to(master, cycle->sync_time);
+    }
+    if (cycle->operations & EC_CYCLE_SYNC_SLAVES) {
+        ecrt_master_sync_slave_clocks(master);
+    }
+    if (cycle->operations & EC_CYCLE_SYNC_MON) {
+        ecrt_master_sync_monitor_queue(master);
+    }
+
+    if (cycle->operations & EC_CYCLE_QUEUE) {
+        for (i = 0; i < cycle->domain_count; i++) {
+            ecrt_domain_queue(cycle->domains[i].domain);
+        }
+    }
+
+    if (cycle->operations & EC_CYCLE_SEND) {
+        cycle->sent_bytes = ecrt_master_send(master);
+    }
+
+    return 0;
+}
+
+/*****************************************************************************/
+
 int ecrt_master_sdo_download(ec_master_t *master, uint16_t slave_position,
         uint16_t index, uint8_t subindex, const uint8_t *data,
         size_t data_size, uint32_t *abort_code)
@@ -3994,7 +5170,9 @@ void ecrt_master_exec_slave_requests(ec_master_t *master)
     // handle the slave requests from the application
     if (master->rt_slave_requests && master->rt_slaves_available &&
         (master->phase == EC_OPERATION)) {
+        ec_request_ring_submit(&master->request_ring);
         ec_master_exec_slave_fsms(master);
+        ec_request_ring_publish(&master->request_ring);
     }
 
     ec_lock_up(&master->master_sem);
@@ -4688,6 +5866,7 @@ EXPORT_SYMBOL(ecrt_master_64bit_reference_clock_time_queue);
 EXPORT_SYMBOL(ecrt_master_64bit_reference_clock_time);
 EXPORT_SYMBOL(ecrt_master_sync_monitor_queue);
 EXPORT_SYMBOL(ecrt_master_sync_monitor_process);
+EXPORT_SYMBOL(ecrt_master_cycle);
 EXPORT_SYMBOL(ecrt_master_sdo_download);
 EXPORT_SYMBOL(ecrt_master_sdo_download_complete);
 EXPORT_SYMBOL(ecrt_master_sdo_upload);
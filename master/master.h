@@ -49,6 +49,7 @@
 #include "fsm_master.h"
 #include "locks.h"
 #include "cdev.h"
+#include "request_ring.h"
 
 #ifdef EC_RTDM
 #include "rtdm.h"
@@ -114,9 +115,11 @@
 
 /** Size of the external datagram ring.
  *
- * The external datagram ring is used for slave FSMs.
+ * The external datagram ring is used for slave FSMs. As every executing
+ * slave FSM owns one datagram, this also limits the number of slave FSMs
+ * executed in parallel.
  */
-#define EC_EXT_RING_SIZE 32
+#define EC_EXT_RING_SIZE 64
 
 /** return flag from ecrt_master_eoe_process() to indicate there is
  * something to send.  if this flag is set call ecrt_master_send_ext()
@@ -150,6 +153,9 @@ typedef enum {
  */
 typedef struct {
     unsigned int timeouts; /**< datagram timeouts */
+    unsigned int last_cycle_timeouts; /**< datagram timeouts of the last
+                                        ecrt_master_receive() call */
+    u64 total_timeouts; /**< datagram timeouts since master start */
     unsigned int corrupted; /**< corrupted frames */
     unsigned int unmatched; /**< unmatched datagrams (received, but not
                                queued any longer) */
@@ -184,11 +190,30 @@ typedef struct {
                                         different statistics cycle periods. */
     s32 loss_rates[EC_RATE_COUNT]; /**< Frame loss rates for different
                                      statistics cycle periods. */
+    u64 cycle_count; /**< Number of send cycles, that sent frames. */
+    u64 cycle_frames; /**< Number of frames sent in all send cycles. */
+    u64 cycle_frame_bytes; /**< EtherCAT payload bytes of all frames sent in
+                             send cycles (without padding). */
+    unsigned int last_cycle_frames; /**< Frames sent in the last send
+                                      cycle. */
     unsigned long jiffies; /**< Jiffies of last statistic cycle. */
 } ec_device_stats_t;
 
 /*****************************************************************************/
 
+/** Datagram round-trip latency statistics.
+ */
+typedef struct {
+    u64 count; /**< Number of received datagrams. */
+    u64 sum_ns; /**< Sum of all round-trip times [ns]. */
+    u32 min_ns; /**< Minimum round-trip time [ns]. */
+    u32 max_ns; /**< Maximum round-trip time [ns]. */
+    u64 bins[EC_LATENCY_BIN_COUNT]; /**< Logarithmic histogram, see
+                                      EC_LATENCY_BIN_COUNT. */
+} ec_latency_stats_t;
+
+/*****************************************************************************/
+
 #if EC_MAX_NUM_DEVICES < 1
 #error Invalid number of devices
 #endif
@@ -230,14 +255,28 @@ struct ec_master {
     ec_datagram_t fsm_datagram; /**< Datagram used for state machines. */
     ec_master_phase_t phase; /**< Master phase. */
     unsigned int active; /**< Master has been activated. */
+    unsigned long activate_jiffies; /**< Time of the last activation. */
+    unsigned int op_pending; /**< Not all slaves reached OP since the last
+                               activation. */
+    unsigned int op_duration; /**< Time from the last activation until all
+                                slaves were in OP in ms. */
+    unsigned int op_grouped; /**< \a True, if the slaves were brought to OP
+                               by a grouped AL state transition. */
+    unsigned int group_op; /**< The transition of the slaves from SAFEOP to
+                             OP shall be done by the master state machine
+                             for all slaves at once. */
     unsigned int config_changed; /**< The configuration changed. */
     unsigned int injection_seq_fsm; /**< Datagram injection sequence number
                                       for the FSM side. */
     unsigned int injection_seq_rt; /**< Datagram injection sequence number
                                      for the realtime side. */
 
-    ec_slave_t *slaves; /**< Array of slaves on the bus. */
-    unsigned int slave_count; /**< Number of slaves on the bus. */
+    ec_slave_t *slaves; /**< Array of slaves on the bus. Changed under
+                          \a io_sem, see ec_master_set_slaves(). */
+    unsigned int slave_count; /**< Number of slaves on the bus. Changed
+                                under \a io_sem. */
+    unsigned int slave_capacity; /**< Number of slaves the \a slaves array
+                                   can hold without reallocation. */
 
     /* Configuration applied by the application. */
     struct list_head configs; /**< List of slave configurations. */
@@ -257,12 +296,29 @@ struct ec_master {
                                      slave system clock time. */
     ec_datagram_t sync_mon_datagram; /**< Datagram used for DC synchronisation
                                        monitoring. */
+    ec_datagram_t mbox_status_datagram; /**< Datagram reading the mapped
+                                          mailbox states of all slaves. */
+    struct list_head mbox_check_queue; /**< Mailbox check datagrams waiting
+                                         for the next mailbox status
+                                         datagram. */
+    struct list_head mbox_check_sent; /**< Mailbox check datagrams answered
+                                        by the pending mailbox status
+                                        datagram. */
+    uint16_t mbox_status_wc; /**< Expected working counter of the pending
+                               mailbox status datagram. */
+    u64 mbox_status_reads; /**< Number of mailbox status datagrams sent. */
+    u64 mbox_status_checks; /**< Number of mailbox checks answered by the
+                              mailbox status datagram instead of a separate
+                              datagram. */
     ec_slave_config_t *dc_ref_config; /**< Application-selected DC reference
                                         clock slave config. */
     ec_slave_t *dc_ref_clock; /**< DC reference clock slave. */
 
     unsigned int reboot; /**< Reboot requested. */
     unsigned int scan_busy; /**< Current scan state. */
+    unsigned int scan_duration; /**< Duration of the last bus scan in ms. */
+    unsigned int scan_incremental; /**< \a True, if the last bus scan only
+                                     covered the changed bus segment. */
     unsigned int allow_scan; /**< \a True, if slave scanning is allowed. */
     ec_lock_t scan_sem; /**< Semaphore protecting the \a scan_busy
                                  variable and the \a allow_scan flag. */
@@ -277,6 +333,11 @@ struct ec_master {
 
     struct list_head datagram_queue; /**< Datagram queue. */
     uint8_t datagram_index; /**< Current datagram index. */
+    struct list_head sent_queue; /**< Sent datagrams, ordered by sending
+                                   time. */
+    ec_datagram_t *datagram_table[EC_DATAGRAM_INDEX_COUNT]; /**< Sent
+                                                              datagrams by
+                                                              index. */
 
     struct list_head ext_datagram_queue; /**< Queue for non-application
                                            datagrams. */
@@ -284,7 +345,10 @@ struct ec_master {
                                       ext_datagram_queue. */
 
     ec_datagram_t ext_datagram_ring[EC_EXT_RING_SIZE]; /**< External datagram
-                                                         ring. */
+                                                         pool. */
+    ec_datagram_t *ext_ring[EC_EXT_RING_SIZE]; /**< External datagrams
+                                                 handed over to the RT side.
+                                                 */
     unsigned int ext_ring_idx_rt; /**< Index in external datagram ring for RT
                                     side. */
     unsigned int ext_ring_idx_fsm; /**< Index in external datagram ring for
@@ -309,6 +373,18 @@ struct ec_master {
 
     unsigned int debug_level; /**< Master debug level. */
     ec_stats_t stats; /**< Cyclic statistics. */
+    ec_latency_stats_t latency_stats[EC_MAX_NUM_DEVICES]
+        [EC_DATAGRAM_CLASS_COUNT]; /**< Datagram round-trip latency
+                                     statistics per sending device and
+                                     datagram class. */
+
+    struct ec_ioctl_status *status; /**< Status page, exported read-only
+                                      via the memory mapping in \a
+                                      OPERATION phase. */
+    size_t status_size; /**< Size of the status page in bytes (page
+                          aligned). */
+    ec_request_ring_t request_ring; /**< Request ring for userspace
+                                      applications. */
 
     void *pcap_data; /**< pcap debug output memory pointer */
     void *pcap_curr_data; /**< pcap debug output current memory pointer */
@@ -320,7 +396,12 @@ struct ec_master {
     struct list_head eoe_handlers; /**< Ethernet over EtherCAT handlers. */
 #endif
 
-    ec_lock_t io_sem; /**< Semaphore used in \a IDLE phase. */
+    ec_lock_t io_sem; /**< Semaphore serializing datagram queue access
+                        (sending, receiving, domain queueing) of the master
+                        thread in \a IDLE phase and of the application in
+                        \a OPERATION phase. Also protects the slave array
+                        used by the receive path. Never held while
+                        executing state machines. */
 
     void (*send_cb)(void *); /**< Current send datagrams callback. */
     void (*receive_cb)(void *); /**< Current receive datagrams callback. */
@@ -337,6 +418,17 @@ struct ec_master {
 
     wait_queue_head_t request_queue; /**< Wait queue for external requests
                                        from user space. */
+
+    wait_queue_head_t event_queue; /**< Wait queue for processes polling for
+                                     master events. */
+    spinlock_t event_lock; /**< Lock for \a event_counts and
+                             \a event_bindings. */
+    unsigned int event_counts[EC_EVENT_COUNT]; /**< Number of signals per
+                                                 event type. */
+    unsigned long events_posted; /**< Events posted from realtime context,
+                                   that are signalled by the master
+                                   thread. */
+    struct list_head event_bindings; /**< Bindings of events to eventfds. */
 };
 
 /*****************************************************************************/
@@ -385,13 +477,36 @@ ec_slave_t *ec_master_find_slave(ec_master_t *, uint16_t, uint16_t);
 const ec_slave_t *ec_master_find_slave_const(const ec_master_t *, uint16_t,
         uint16_t);
 void ec_master_output_stats(ec_master_t *);
+void ec_master_clear_latency_stats(ec_master_t *);
+void ec_master_status_update(ec_master_t *);
+
+struct ec_event_binding;
+void ec_master_signal_event(ec_master_t *, uint32_t);
+void ec_master_post_event(ec_master_t *, uint32_t);
+void ec_master_flush_events(ec_master_t *);
+uint32_t ec_master_pending_events(ec_master_t *, const unsigned int *,
+        uint32_t);
+uint32_t ec_master_fetch_events(ec_master_t *, unsigned int *, uint32_t);
+void ec_master_init_event_binding(struct ec_event_binding *);
+int ec_master_bind_eventfd(ec_master_t *, struct ec_event_binding *, int,
+        uint32_t);
+void ec_master_unbind_eventfd(ec_master_t *, struct ec_event_binding *);
+void ec_master_status_update_domain(ec_master_t *, const ec_domain_t *);
 #ifdef EC_EOE
 void ec_master_clear_eoe_handlers(ec_master_t *, unsigned int);
 #endif
 void ec_master_slaves_not_available(ec_master_t *);
 void ec_master_slaves_available(ec_master_t *);
+void ec_master_set_slaves(ec_master_t *, ec_slave_t *, unsigned int);
 void ec_master_clear_slaves(ec_master_t *);
+void ec_master_remove_slaves(ec_master_t *, unsigned int);
 void ec_master_clear_sii_images(ec_master_t *);
+#ifdef EC_SII_CACHE
+unsigned int ec_master_sii_cache_count(const ec_master_t *);
+const ec_sii_image_t *ec_master_get_cached_sii_image(const ec_master_t *,
+        unsigned int);
+int ec_master_add_cached_sii_image(ec_master_t *, const uint16_t *, size_t);
+#endif
 void ec_master_reboot_slaves(ec_master_t *);
 
 unsigned int ec_master_config_count(const ec_master_t *);
@@ -439,6 +554,8 @@ extern unsigned int eoe_count; // see module.c
 extern bool eoe_autocreate; // see module.c
 #endif
 extern unsigned long pcap_size;  // see module.c
+extern bool mbox_status_fmmu; // see module.c
+extern bool group_transitions; // see module.c
 
 /*****************************************************************************/
 
@@ -65,6 +65,9 @@ bool eoe_autocreate = 1;  /**< Auto-create EOE interfaces. */
 #endif
 static unsigned int debug_level;  /**< Debug level parameter. */
 unsigned long pcap_size;  /**< Pcap buffer size in bytes. */
+bool mbox_status_fmmu; /**< Map the mailbox status via FMMUs. */
+bool group_transitions; /**< Bring slaves to OP with grouped AL state
+                           transitions. */
 
 static ec_master_t *masters; /**< Array of masters. */
 static ec_lock_t master_sem; /**< Master semaphore. */
@@ -99,6 +102,10 @@ module_param_named(debug_level, debug_level, uint, S_IRUGO);
 MODULE_PARM_DESC(debug_level, "Debug level");
 module_param_named(pcap_size, pcap_size, ulong, S_IRUGO);
 MODULE_PARM_DESC(pcap_size, "Pcap buffer size");
+module_param_named(mbox_status_fmmu, mbox_status_fmmu, bool, S_IRUGO);
+MODULE_PARM_DESC(mbox_status_fmmu, "Poll mailbox states via FMMUs");
+module_param_named(group_transitions, group_transitions, bool, S_IRUGO);
+MODULE_PARM_DESC(group_transitions, "Group SAFEOP to OP transitions");
 
 /** \endcond */
 
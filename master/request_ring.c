@@ -0,0 +1,543 @@
+/******************************************************************************
+ *
+ *  $Id$
+ *
+ *  Copyright (C) 2006-2012  Florian Pose, Ingenieurgemeinschaft IgH
+ *
+ *  This file is part of the IgH EtherCAT Master.
+ *
+ *  The IgH EtherCAT Master is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License version 2, as
+ *  published by the Free Software Foundation.
+ *
+ *  The IgH EtherCAT Master is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ *  Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with the IgH EtherCAT Master; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *  ---
+ *
+ *  The license mentioned above concerns the source code only. Using the
+ *  EtherCAT technology and brand is only permitted in compliance with the
+ *  industrial property and similar rights of Beckhoff Automation GmbH.
+ *
+ *****************************************************************************/
+
+/** \file
+ * EtherCAT request ring methods.
+ */
+
+/*****************************************************************************/
+
+#include <linux/slab.h>
+#include <linux/vmalloc.h>
+#include <linux/log2.h>
+
+#include "master.h"
+#include "slave_config.h"
+#include "sdo_request.h"
+#include "reg_request.h"
+#include "foe_request.h"
+#include "ioctl.h"
+#include "request_ring.h"
+
+/*****************************************************************************/
+
+/** Minimum number of submission slots.
+ */
+#define EC_REQUEST_RING_MIN_SUBS 16
+
+/** Alignment of the data areas.
+ */
+#define EC_REQUEST_RING_ALIGN(SIZE) ALIGN(SIZE, 8)
+
+/*****************************************************************************/
+
+/** Request ring constructor.
+ */
+void ec_request_ring_init(
+        ec_request_ring_t *ring, /**< Request ring. */
+        ec_master_t *master /**< EtherCAT master. */
+        )
+{
+    ring->master = master;
+    ring->mem = NULL;
+    ring->mem_size = 0;
+    ring->subs = NULL;
+    ring->sub_count = 0;
+    ring->sub_tail = 0;
+    ring->entries = NULL;
+    ring->slots = NULL;
+    ring->slot_count = 0;
+}
+
+/*****************************************************************************/
+
+/** Request ring destructor.
+ */
+void ec_request_ring_clear(
+        ec_request_ring_t *ring /**< Request ring. */
+        )
+{
+    ec_request_ring_free(ring);
+}
+
+/*****************************************************************************/
+
+/** Frees the shared memory and the entries.
+ */
+void ec_request_ring_free(
+        ec_request_ring_t *ring /**< Request ring. */
+        )
+{
+    if (ring->mem) {
+        vfree(ring->mem);
+        ring->mem = NULL;
+        ring->mem_size = 0;
+    }
+
+    if (ring->slots) {
+        kfree(ring->slots);
+        ring->slots = NULL;
+        ring->slot_count = 0;
+    }
+
+    ring->subs = NULL;
+    ring->sub_count = 0;
+    ring->sub_tail = 0;
+    ring->entries = NULL;
+}
+
+/*****************************************************************************/
+
+/** Sets up a request entry.
+ */
+static void ec_request_ring_init_slot(
+        ec_request_ring_t *ring, /**< Request ring. */
+        unsigned int index, /**< Entry index. */
+        unsigned int type, /**< Request type. */
+        void *request, /**< SDO, register or FoE request. */
+        unsigned int config_index, /**< Slave configuration index. */
+        unsigned int request_index, /**< Request index. */
+        size_t mem_size, /**< Size of the data area. */
+        size_t *offset /**< Offset of the data area (in/out). */
+        )
+{
+    ec_request_ring_slot_t *slot = &ring->slots[index];
+    ec_ioctl_ring_entry_t *entry = &ring->entries[index];
+
+    slot->type = type;
+    slot->request = request;
+    slot->mem_size = mem_size;
+    slot->data = (uint8_t *) ring->mem + *offset;
+    slot->sequence = 0;
+    slot->state = EC_REQUEST_UNUSED;
+    slot->failed = 0;
+
+    entry->type = type;
+    entry->config_index = config_index;
+    entry->request_index = request_index;
+    entry->mem_size = mem_size;
+    entry->data_offset = *offset;
+    entry->state = EC_REQUEST_UNUSED;
+
+    *offset += EC_REQUEST_RING_ALIGN(mem_size);
+}
+
+/*****************************************************************************/
+
+/** Allocates the shared memory for the requests of all slave
+ * configurations.
+ *
+ * Has to be called with the master_sem held, before the application
+ * submits requests.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+int ec_request_ring_alloc(
+        ec_request_ring_t *ring /**< Request ring. */
+        )
+{
+    ec_master_t *master = ring->master;
+    ec_slave_config_t *sc;
+    ec_sdo_request_t *sdo;
+    ec_reg_request_t *reg;
+    ec_foe_request_t *foe;
+    unsigned int slot_count = 0, index = 0, config_index = 0,
+                 request_index;
+    size_t data_size = 0, offset;
+
+    ec_request_ring_free(ring);
+
+    list_for_each_entry(sc, &master->configs, list) {
+        list_for_each_entry(sdo, &sc->sdo_requests, list) {
+            slot_count++;
+            data_size += EC_REQUEST_RING_ALIGN(sdo->mem_size);
+        }
+        list_for_each_entry(reg, &sc->reg_requests, list) {
+            slot_count++;
+            data_size += EC_REQUEST_RING_ALIGN(reg->mem_size);
+        }
+        list_for_each_entry(foe, &sc->foe_requests, list) {
+            slot_count++;
+            data_size += EC_REQUEST_RING_ALIGN(foe->buffer_size);
+        }
+    }
+
+    if (!slot_count) {
+        return 0;
+    }
+
+    ring->slots = kmalloc(sizeof(ec_request_ring_slot_t) * slot_count,
+            GFP_KERNEL);
+    if (!ring->slots) {
+        EC_MASTER_ERR(master, "Failed to allocate %u request ring"
+                " entries!\n", slot_count);
+        return -ENOMEM;
+    }
+    ring->slot_count = slot_count;
+
+    ring->sub_count = roundup_pow_of_two(
+            max(2 * slot_count, (unsigned int) EC_REQUEST_RING_MIN_SUBS));
+
+    offset = EC_REQUEST_RING_ALIGN(sizeof(ec_ioctl_ring_t)
+            + ring->sub_count * sizeof(ec_ioctl_ring_sub_t)
+            + slot_count * sizeof(ec_ioctl_ring_entry_t));
+    ring->mem_size = PAGE_ALIGN(offset + data_size);
+
+    ring->mem = vmalloc(ring->mem_size);
+    if (!ring->mem) {
+        EC_MASTER_ERR(master, "Failed to allocate %zu bytes"
+                " of request ring memory!\n", ring->mem_size);
+        ec_request_ring_free(ring);
+        return -ENOMEM;
+    }
+
+    memset(ring->mem, 0x00, ring->mem_size);
+    ring->mem->sub_count = ring->sub_count;
+    ring->mem->entry_count = slot_count;
+    ring->subs = EC_IOCTL_RING_SUBS(ring->mem);
+    ring->entries = EC_IOCTL_RING_ENTRIES(ring->mem);
+
+    list_for_each_entry(sc, &master->configs, list) {
+        request_index = 0;
+        list_for_each_entry(sdo, &sc->sdo_requests, list) {
+            ec_request_ring_init_slot(ring, index++, EC_IOCTL_RING_SDO, sdo,
+                    config_index, request_index++, sdo->mem_size, &offset);
+        }
+        request_index = 0;
+        list_for_each_entry(reg, &sc->reg_requests, list) {
+            ec_request_ring_init_slot(ring, index++, EC_IOCTL_RING_REG, reg,
+                    config_index, request_index++, reg->mem_size, &offset);
+        }
+        request_index = 0;
+        list_for_each_entry(foe, &sc->foe_requests, list) {
+            ec_request_ring_init_slot(ring, index++, EC_IOCTL_RING_FOE, foe,
+                    config_index, request_index++, foe->buffer_size,
+                    &offset);
+        }
+        config_index++;
+    }
+
+    EC_MASTER_DBG(master, 1, "Request ring with %u entries and %u"
+            " submission slots (%zu bytes).\n", slot_count, ring->sub_count,
+            ring->mem_size);
+    return 0;
+}
+
+/*****************************************************************************/
+
+/** Starts an SDO request from a submission.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static int ec_request_ring_start_sdo(
+        ec_sdo_request_t *req, /**< SDO request. */
+        const ec_ioctl_ring_sub_t *sub, /**< Submission. */
+        const uint8_t *data /**< Data area. */
+        )
+{
+    int ret;
+
+    switch (sub->command) {
+        case EC_IOCTL_RING_READ:
+            ecrt_sdo_request_read(req);
+            return 0;
+        case EC_IOCTL_RING_WRITE:
+            if (!sub->size) {
+                return -EINVAL;
+            }
+            ret = ec_sdo_request_alloc(req, sub->size);
+            if (ret) {
+                return ret;
+            }
+            memcpy(req->data, data, sub->size);
+            req->data_size = sub->size;
+            ecrt_sdo_request_write(req);
+            return 0;
+        default:
+            return -EINVAL;
+    }
+}
+
+/*****************************************************************************/
+
+/** Starts a register request from a submission.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static int ec_request_ring_start_reg(
+        ec_reg_request_t *reg, /**< Register request. */
+        const ec_ioctl_ring_sub_t *sub, /**< Submission. */
+        const uint8_t *data /**< Data area. */
+        )
+{
+    switch (sub->command) {
+        case EC_IOCTL_RING_READ:
+            ecrt_reg_request_read(reg, sub->address, sub->size);
+            return 0;
+        case EC_IOCTL_RING_WRITE:
+            memcpy(reg->data, data, sub->size);
+            ecrt_reg_request_write(reg, sub->address, sub->size);
+            return 0;
+        case EC_IOCTL_RING_READWRITE:
+            memcpy(reg->data, data, sub->size);
+            ecrt_reg_request_readwrite(reg, sub->address, sub->size);
+            return 0;
+        default:
+            return -EINVAL;
+    }
+}
+
+/*****************************************************************************/
+
+/** Starts an FoE request from a submission.
+ *
+ * \return Zero on success, otherwise a negative error code.
+ */
+static int ec_request_ring_start_foe(
+        ec_foe_request_t *req, /**< FoE request. */
+        const ec_ioctl_ring_sub_t *sub, /**< Submission. */
+        const uint8_t *data /**< Data area. */
+        )
+{
+    int ret;
+
+    switch (sub->command) {
+        case EC_IOCTL_RING_READ:
+            ecrt_foe_request_read(req);
+            return 0;
+        case EC_IOCTL_RING_WRITE:
+            ret = ec_foe_request_alloc(req, sub->size);
+            if (ret) {
+                return ret;
+            }
+            memcpy(req->buffer, data, sub->size);
+            ecrt_foe_request_write(req, sub->size);
+            return 0;
+        default:
+            return -EINVAL;
+    }
+}
+
+/*****************************************************************************/
+
+/** Starts the request of a submission.
+ */
+static void ec_request_ring_start(
+        ec_request_ring_t *ring, /**< Request ring. */
+        const ec_ioctl_ring_sub_t *sub /**< Submission. */
+        )
+{
+    ec_request_ring_slot_t *slot;
+    ec_ioctl_ring_entry_t *entry;
+    int ret;
+
+    if (sub->entry >= ring->slot_count) {
+        EC_MASTER_WARN(ring->master, "Invalid request ring entry %u!\n",
+                sub->entry);
+        return;
+    }
+
+    slot = &ring->slots[sub->entry];
+    entry = &ring->entries[sub->entry];
+
+    if (sub->size > slot->mem_size) {
+        ret = -EOVERFLOW;
+    } else {
+        switch (slot->type) {
+            case EC_IOCTL_RING_SDO:
+                ret = ec_request_ring_start_sdo(slot->request, sub,
+                        slot->data);
+                break;
+            case EC_IOCTL_RING_REG:
+                ret = ec_request_ring_start_reg(slot->request, sub,
+                        slot->data);
+                break;
+            case EC_IOCTL_RING_FOE:
+                ret = ec_request_ring_start_foe(slot->request, sub,
+                        slot->data);
+                break;
+            default:
+                ret = -EINVAL;
+                break;
+        }
+    }
+
+    if (ret) {
+        EC_MASTER_ERR(ring->master, "Failed to start request of ring"
+                " entry %u (command %u, size %u): error %i\n",
+                sub->entry, sub->command, sub->size, ret);
+        slot->state = EC_REQUEST_ERROR;
+        ec_master_post_event(ring->master, EC_EVENT_REQUEST);
+    } else {
+        slot->state = EC_REQUEST_BUSY;
+    }
+    slot->failed = ret != 0;
+
+    entry->data_size = 0;
+    entry->state = slot->state;
+    smp_wmb(); /* state before the sequence */
+    entry->sequence = ++slot->sequence;
+}
+
+/*****************************************************************************/
+
+/** Consumes the pending submissions.
+ *
+ * Called from the master thread with the master_sem held, before executing
+ * the slave state machines.
+ */
+void ec_request_ring_submit(
+        ec_request_ring_t *ring /**< Request ring. */
+        )
+{
+    ec_ioctl_ring_sub_t sub;
+    unsigned int head;
+
+    if (!ring->mem) {
+        return;
+    }
+
+    head = ring->mem->sub_head;
+    smp_rmb(); /* head before the submissions */
+
+    if (head == ring->sub_tail) {
+        return;
+    }
+
+    if (head - ring->sub_tail > ring->sub_count) {
+        EC_MASTER_WARN(ring->master, "Invalid request ring head %u"
+                " (tail %u)!\n", head, ring->sub_tail);
+        ring->sub_tail = head;
+    }
+
+    while (ring->sub_tail != head) {
+        // take a copy, the application may change the slot at any time
+        sub = ring->subs[ring->sub_tail & (ring->sub_count - 1)];
+        ec_request_ring_start(ring, &sub);
+        ring->sub_tail++;
+    }
+
+    smp_mb(); /* submissions consumed before they are released */
+    ring->mem->sub_tail = ring->sub_tail;
+}
+
+/*****************************************************************************/
+
+/** Publishes the states and the received data of the requests.
+ *
+ * Called from the master thread with the master_sem held, after executing
+ * the slave state machines. Data are only copied once per completed
+ * request. Completions are signalled as EC_EVENT_REQUEST.
+ */
+void ec_request_ring_publish(
+        ec_request_ring_t *ring /**< Request ring. */
+        )
+{
+    ec_request_ring_slot_t *slot;
+    ec_ioctl_ring_entry_t *entry;
+    ec_request_state_t state;
+    const uint8_t *data;
+    size_t size;
+    int input, completed = 0;
+    unsigned int i;
+
+    for (i = 0; i < ring->slot_count; i++) {
+        slot = &ring->slots[i];
+        entry = &ring->entries[i];
+
+        if (slot->failed) {
+            continue;
+        }
+
+        switch (slot->type) {
+            case EC_IOCTL_RING_SDO:
+                {
+                    ec_sdo_request_t *req = slot->request;
+                    state = ecrt_sdo_request_state(req);
+                    input = req->dir == EC_DIR_INPUT;
+                    data = req->data;
+                    size = req->data_size;
+                }
+                break;
+            case EC_IOCTL_RING_REG:
+                {
+                    ec_reg_request_t *reg = slot->request;
+                    state = ecrt_reg_request_state(reg);
+                    input = reg->dir == EC_DIR_INPUT
+                        || reg->dir == EC_DIR_BOTH;
+                    data = reg->data;
+                    size = reg->transfer_size;
+                }
+                break;
+            case EC_IOCTL_RING_FOE:
+                {
+                    ec_foe_request_t *req = slot->request;
+                    state = ecrt_foe_request_state(req);
+                    // streamed data are pulled in chunks
+                    input = req->dir == EC_DIR_INPUT && !req->stream;
+                    data = req->buffer;
+                    size = req->data_size;
+                    entry->progress = req->progress;
+                    entry->result = req->result;
+                    entry->error_code = req->error_code;
+                }
+                break;
+            default:
+                continue;
+        }
+
+        if (state == slot->state) {
+            continue;
+        }
+
+        if (state == EC_REQUEST_SUCCESS && input) {
+            // the application reports an error for oversized data
+            if (size <= slot->mem_size) {
+                memcpy(slot->data, data, size);
+            }
+            entry->data_size = size;
+        } else {
+            entry->data_size = 0;
+        }
+
+        smp_wmb(); /* data before the state */
+        entry->state = state;
+        slot->state = state;
+
+        if (state == EC_REQUEST_SUCCESS || state == EC_REQUEST_ERROR) {
+            completed = 1;
+        }
+    }
+
+    if (completed) {
+        ec_master_post_event(ring->master, EC_EVENT_REQUEST);
+    }
+}
+
+/*****************************************************************************/
@@ -0,0 +1,99 @@
+/******************************************************************************
+ *
+ *  $Id$
+ *
+ *  Copyright (C) 2006-2012  Florian Pose, Ingenieurgemeinschaft IgH
+ *
+ *  This file is part of the IgH EtherCAT Master.
+ *
+ *  The IgH EtherCAT Master is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License version 2, as
+ *  published by the Free Software Foundation.
+ *
+ *  The IgH EtherCAT Master is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ *  Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with the IgH EtherCAT Master; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *  ---
+ *
+ *  The license mentioned above concerns the source code only. Using the
+ *  EtherCAT technology and brand is only permitted in compliance with the
+ *  industrial property and similar rights of Beckhoff Automation GmbH.
+ *
+ *****************************************************************************/
+
+/**
+   \file
+   EtherCAT request ring structure.
+*/
+
+/*****************************************************************************/
+
+#ifndef __EC_REQUEST_RING_H__
+#define __EC_REQUEST_RING_H__
+
+#include "globals.h"
+
+/*****************************************************************************/
+
+struct ec_ioctl_ring;
+struct ec_ioctl_ring_sub;
+struct ec_ioctl_ring_entry;
+
+/*****************************************************************************/
+
+/** Master-side view of a request ring entry.
+ *
+ * The shared memory may be modified by the application at any time, so the
+ * master keeps its own copy of everything it relies on.
+ */
+typedef struct {
+    unsigned int type; /**< Request type (EC_IOCTL_RING_SDO, ...). */
+    void *request; /**< SDO, register or FoE request. */
+    size_t mem_size; /**< Size of the data area. */
+    uint8_t *data; /**< Data area in the shared memory. */
+    uint32_t sequence; /**< Number of consumed submissions. */
+    ec_request_state_t state; /**< Last published request state. */
+    int failed; /**< The last submission could not be started. */
+} ec_request_ring_slot_t;
+
+/*****************************************************************************/
+
+/** Shared-memory submission ring for application requests.
+ *
+ * Lets a userspace application start SDO, register and FoE requests and
+ * reap their results without calling ioctl().
+ */
+typedef struct {
+    ec_master_t *master; /**< Parent master. */
+
+    struct ec_ioctl_ring *mem; /**< Shared memory, exported via mmap(). */
+    size_t mem_size; /**< Size of \a mem (page aligned). */
+
+    struct ec_ioctl_ring_sub *subs; /**< Submission slots in \a mem. */
+    unsigned int sub_count; /**< Number of submission slots. */
+    unsigned int sub_tail; /**< Index of the next submission to consume. */
+
+    struct ec_ioctl_ring_entry *entries; /**< Request entries in \a mem. */
+    ec_request_ring_slot_t *slots; /**< Master-side entry data. */
+    unsigned int slot_count; /**< Number of request entries. */
+} ec_request_ring_t;
+
+/*****************************************************************************/
+
+void ec_request_ring_init(ec_request_ring_t *, ec_master_t *);
+void ec_request_ring_clear(ec_request_ring_t *);
+
+int ec_request_ring_alloc(ec_request_ring_t *);
+void ec_request_ring_free(ec_request_ring_t *);
+void ec_request_ring_submit(ec_request_ring_t *);
+void ec_request_ring_publish(ec_request_ring_t *);
+
+/*****************************************************************************/
+
+#endif
@@ -87,6 +87,8 @@ void ec_slave_init(
     slave->last_al_error = 0;
     slave->error_flag = 0;
     slave->force_config = 0;
+    slave->group_op = 0;
+    slave->group_op_failed = 0;
     slave->reboot = 0;
     slave->configured_rx_mailbox_offset = 0x0000;
     slave->configured_rx_mailbox_size = 0x0000;
@@ -132,6 +134,9 @@ void ec_slave_init(
     INIT_LIST_HEAD(&slave->sdo_dictionary);
 
     slave->scan_required = 1;
+    slave->config_duration = 0;
+    slave->config_round_trips = 0;
+    slave->scan_ports_only = 0;
     slave->sdo_dictionary_fetched = 0;
     slave->jiffies_preop = 0;
 
@@ -148,6 +153,7 @@ void ec_slave_init(
 
     slave->read_mbox_busy = 0;
     rt_mutex_init(&slave->mbox_sem);
+    slave->mbox_status_mapped = 0;
 
 #ifdef EC_EOE
     ec_mbox_data_init(&slave->mbox_eoe_frag_data);
@@ -171,6 +177,7 @@ void ec_slave_sii_image_init(
 
     sii_image->words = NULL;
     sii_image->nwords = 0;
+    sii_image->loaded = 0;
 
     sii_image->sii.alias = 0x0000;
     sii_image->sii.vendor_id = 0x00000000;
@@ -409,6 +416,8 @@ void ec_slave_set_dl_status(ec_slave_t *slave, /**< EtherCAT slave */
 
 /**
  * Sets the application state of a slave.
+ *
+ * Posts EC_EVENT_AL_STATE to the master, if the state changed.
  */
 
 void ec_slave_set_al_status(ec_slave_t *slave, /**< EtherCAT slave */
@@ -424,6 +433,7 @@ void ec_slave_set_al_status(ec_slave_t *slave, /**< EtherCAT slave */
             EC_SLAVE_DBG(slave, 0, "%s -> %s.\n", old_state, cur_state);
         }
         slave->current_state = new_state;
+        ec_master_post_event(slave->master, EC_EVENT_AL_STATE);
     }
 }
 
@@ -439,6 +449,7 @@ void ec_slave_request_state(ec_slave_t *slave, /**< EtherCAT slave */
 {
     slave->requested_state = state;
     slave->error_flag = 0;
+    slave->group_op = 0;
 }
 
 /*****************************************************************************/
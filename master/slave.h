@@ -203,6 +203,8 @@ typedef struct {
 
     uint16_t *words;
     size_t nwords; /**< Size of the SII contents in words. */
+    uint8_t loaded; /**< The words were loaded from the persistent SII
+                      cache and have not been validated and parsed yet. */
 
     ec_sii_t sii; /**< Extracted SII data. */
 } ec_sii_image_t;
@@ -238,6 +240,10 @@ struct ec_slave
     uint16_t last_al_error; /**< Last AL state error code */
     unsigned int error_flag; /**< Stop processing after an error. */
     unsigned int force_config; /**< Force (re-)configuration. */
+    unsigned int group_op; /**< Waiting in SAFEOP for the grouped transition
+                             to OP. */
+    unsigned int group_op_failed; /**< The grouped transition to OP failed,
+                                    change the state individually. */
     unsigned int reboot; /**< Request reboot */
     uint16_t configured_rx_mailbox_offset; /**< Configured receive mailbox
                                              offset. */
@@ -268,6 +274,12 @@ struct ec_slave
 
     struct list_head sdo_dictionary; /**< SDO dictionary list */
     uint8_t scan_required; /**< Scan required. */
+    unsigned int config_duration; /**< Duration of the last configuration
+                                    in ms. */
+    unsigned int config_round_trips; /**< Datagrams sent during the last
+                                       configuration. */
+    uint8_t scan_ports_only; /**< Only refresh the port states during the
+                               next scan, the slave is already known. */
     uint8_t sdo_dictionary_fetched; /**< Dictionary has been fetched. */
     unsigned long jiffies_preop; /**< Time, the slave went to PREOP. */
 
@@ -282,6 +294,9 @@ struct ec_slave
     ec_fsm_slave_t fsm; /**< Slave state machine. */
 
     uint8_t read_mbox_busy; /**< Flag set during a mailbox read request. */
+    uint8_t mbox_status_mapped; /**< The mailbox status is mapped into the
+                                  master's mailbox status datagram via an
+                                  FMMU. */
     struct rt_mutex mbox_sem; /**< Semaphore protecting the check_mbox variable. */
 
 #ifdef EC_EOE
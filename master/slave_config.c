@@ -174,6 +174,10 @@ void ec_slave_config_clear(
  * FMMU configuration is already prepared, the function does nothing and
  * returns with success.
  *
+ * If \a sync_index is \a EC_SYNC_REGISTERS, the FMMU maps the ESC register
+ * range given by \a address and \a size for reading instead. An FMMU
+ * already covering the range is reused.
+ *
  * \retval >=0 Success, logical offset byte address.
  * \retval  <0 Error code.
  */
@@ -181,7 +185,9 @@ int ec_slave_config_prepare_fmmu(
         ec_slave_config_t *sc, /**< Slave configuration. */
         ec_domain_t *domain, /**< Domain. */
         uint8_t sync_index, /**< Sync manager index. */
-        ec_direction_t dir /**< PDO direction. */
+        ec_direction_t dir, /**< PDO direction. */
+        uint16_t address, /**< ESC register address. */
+        uint16_t size /**< Size of the ESC register range. */
         )
 {
     unsigned int i;
@@ -190,8 +196,14 @@ int ec_slave_config_prepare_fmmu(
     // FMMU configuration already prepared?
     for (i = 0; i < sc->used_fmmus; i++) {
         fmmu = &sc->fmmu_configs[i];
-        if (fmmu->domain == domain && fmmu->sync_index == sync_index)
+        if (fmmu->domain != domain || fmmu->sync_index != sync_index)
+            continue;
+        if (sync_index != EC_SYNC_REGISTERS)
             return fmmu->logical_domain_offset;
+        if (address >= fmmu->physical_address && address + size
+                <= fmmu->physical_address + fmmu->register_size)
+            return fmmu->logical_domain_offset
+                + (address - fmmu->physical_address);
     }
 
     if (sc->used_fmmus == EC_MAX_FMMUS) {
@@ -202,7 +214,11 @@ int ec_slave_config_prepare_fmmu(
     fmmu = &sc->fmmu_configs[sc->used_fmmus];
 
     ec_lock_down(&sc->master->master_sem);
-    ec_fmmu_config_init(fmmu, sc, domain, sync_index, dir);
+    if (sync_index == EC_SYNC_REGISTERS) {
+        ec_fmmu_config_init_registers(fmmu, sc, domain, address, size);
+    } else {
+        ec_fmmu_config_init(fmmu, sc, domain, sync_index, dir);
+    }
 
 #if 0 //TODO overlapping PDOs
     // Overlapping PDO Support from 4751747d4e6d
@@ -905,7 +921,7 @@ int ecrt_slave_config_reg_pdo_entry(
                     }
 
                     sync_offset = ec_slave_config_prepare_fmmu(
-                            sc, domain, sync_index, sync_config->dir);
+                            sc, domain, sync_index, sync_config->dir, 0, 0);
                     if (sync_offset < 0)
                         return sync_offset;
 
@@ -969,7 +985,7 @@ int ecrt_slave_config_reg_pdo_entry_pos(
                 }
 
                 sync_offset = ec_slave_config_prepare_fmmu(
-                        sc, domain, sync_index, sync_config->dir);
+                        sc, domain, sync_index, sync_config->dir, 0, 0);
                 if (sync_offset < 0)
                     return sync_offset;
 
@@ -987,6 +1003,28 @@ int ecrt_slave_config_reg_pdo_entry_pos(
 
 /*****************************************************************************/
 
+int ecrt_slave_config_reg_esc_registers(
+        ec_slave_config_t *sc,
+        uint16_t address,
+        uint16_t size,
+        ec_domain_t *domain
+        )
+{
+    EC_CONFIG_DBG(sc, 1, "%s(sc = 0x%p, address = 0x%04X, size = %u,"
+            " domain = 0x%p)\n", __func__, sc, address, size, domain);
+
+    if (!size || address + size > EC_ESC_REGISTER_SIZE) {
+        EC_CONFIG_ERR(sc, "Invalid ESC register range 0x%04X,"
+                " size %u.\n", address, size);
+        return -EINVAL;
+    }
+
+    return ec_slave_config_prepare_fmmu(sc, domain, EC_SYNC_REGISTERS,
+            EC_DIR_INPUT, address, size);
+}
+
+/*****************************************************************************/
+
 void ecrt_slave_config_dc(ec_slave_config_t *sc, uint16_t assign_activate,
         uint32_t sync0_cycle_time, int32_t sync0_shift_time,
         uint32_t sync1_cycle_time, int32_t sync1_shift_time)
@@ -1465,6 +1503,7 @@ EXPORT_SYMBOL(ecrt_slave_config_pdo_mapping_add);
 EXPORT_SYMBOL(ecrt_slave_config_pdo_mapping_clear);
 EXPORT_SYMBOL(ecrt_slave_config_pdos);
 EXPORT_SYMBOL(ecrt_slave_config_reg_pdo_entry);
+EXPORT_SYMBOL(ecrt_slave_config_reg_esc_registers);
 EXPORT_SYMBOL(ecrt_slave_config_dc);
 EXPORT_SYMBOL(ecrt_slave_config_sdo);
 EXPORT_SYMBOL(ecrt_slave_config_sdo8);
@@ -63,6 +63,10 @@ string CommandDomains::helpString(const string &binaryBaseName) const
         << "counter sum. If the values are equal, all PDOs were" << endl
         << "exchanged during the last cycle." << endl
         << endl
+        << "With redundant devices, the working counters per device" << endl
+        << "and the number of process data bytes copied between the" << endl
+        << "main and backup datagrams are shown in addition." << endl
+        << endl
         << "If the --verbose option is given, the participating slave" << endl
         << "configurations/FMMUs and the current process data are" << endl
         << "additionally displayed:" << endl
@@ -163,7 +167,7 @@ void CommandDomains::showDomain(
                 cout << "+";
             }
         }
-        cout << ")";
+        cout << "), Copied " << domain.copied_bytes << " bytes";
     }
     cout << endl;
 
@@ -184,8 +188,13 @@ void CommandDomains::showDomain(
 
         cout << indent << "  SlaveConfig "
             << dec << fmmu.slave_config_alias
-            << ":" << fmmu.slave_config_position
-            << ", SM" << (unsigned int) fmmu.sync_index << " ("
+            << ":" << fmmu.slave_config_position;
+        if (fmmu.sync_index == EC_SYNC_REGISTERS) {
+            cout << ", Registers";
+        } else {
+            cout << ", SM" << (unsigned int) fmmu.sync_index;
+        }
+        cout << " ("
             << setfill(' ') << setw(6)
             << (fmmu.dir == EC_DIR_INPUT ? "Input" : "Output")
             << "), LogAddr 0x"
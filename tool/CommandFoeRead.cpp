@@ -80,10 +80,11 @@ void CommandFoeRead::execute(const StringVector &args)
 {
     SlaveList slaves;
     ec_ioctl_slave_t *slave;
-    ec_ioctl_slave_foe_t data;
+    ec_ioctl_slave_foe_stream_t data;
     stringstream err;
     fstream out_file;
     ostream* out = &cout;
+    uint8_t *buffer;
 
     if (args.size() < 1 || args.size() > 2) {
         err << "'" << getName() << "' takes one or two arguments!";
@@ -98,7 +99,10 @@ void CommandFoeRead::execute(const StringVector &args)
         throwSingleSlaveRequired(slaves.size());
     }
     slave = &slaves.front();
+
+    memset(&data, 0, sizeof(data));
     data.slave_position = slave->position;
+    data.dir = EC_DIR_INPUT;
 
     if (!getOutputFile().empty() && getOutputFile() != "-") {
         out_file.open(getOutputFile().c_str(), ios::out | ios::trunc | ios::binary);
@@ -109,14 +113,7 @@ void CommandFoeRead::execute(const StringVector &args)
         out = &out_file;
     }
 
-    /* FIXME: No good idea to have a fixed buffer size.
-     * Read in chunks and fill a buffer instead.
-     */
     data.password = 0;
-    data.offset = 0;
-    data.buffer_size = 0x8800;
-    data.buffer = new uint8_t[data.buffer_size];
-
     strncpy(data.file_name, args[0].c_str(), sizeof(data.file_name));
     data.file_name[sizeof(data.file_name)-1] = 0;
     if (args.size() >= 2) {
@@ -131,27 +128,53 @@ void CommandFoeRead::execute(const StringVector &args)
         }
     }
 
-    try {
-        m.readFoe(&data);
-    } catch (MasterDeviceException &e) {
-        delete [] data.buffer;
-        if (data.result) {
-            if (data.result == FOE_OPCODE_ERROR) {
-                err << "FoE read aborted with error code 0x"
-                    << setw(8) << setfill('0') << hex << data.error_code
-                    << ": " << errorText(data.error_code);
+    // take the file from the master in chunks
+    buffer = new uint8_t[chunkSize];
+    startTransfer();
+
+    do {
+        data.buffer = buffer;
+        data.size = chunkSize;
+
+        try {
+            m.streamFoe(&data);
+        } catch (MasterDeviceException &e) {
+            delete [] buffer;
+            if (getVerbosity() == Verbose) {
+                cerr << endl;
+            }
+            if (data.result) {
+                if (data.result == FOE_OPCODE_ERROR) {
+                    err << "FoE read aborted with error code 0x"
+                        << setw(8) << setfill('0') << hex << data.error_code
+                        << ": " << errorText(data.error_code);
+                } else {
+                    err << "Failed to read via FoE: "
+                        << resultText(data.result);
+                }
+                throwCommandException(err);
             } else {
-                err << "Failed to read via FoE: "
-                    << resultText(data.result);
+                throw e;
             }
-            throwCommandException(err);
-        } else {
-            throw e;
         }
+
+        out->write((const char *) buffer, data.size);
+
+        if (getVerbosity() == Verbose) {
+            cerr << "\rRead " << data.progress << " bytes." << flush;
+        }
+    } while (!data.done);
+
+    delete [] buffer;
+    out->flush();
+
+    if (getVerbosity() == Verbose) {
+        cerr << endl;
     }
 
-    out->write((const char*) data.buffer, data.data_size);
-    delete [] data.buffer;
+    if (getVerbosity() != Quiet) {
+        cerr << "Read " << transferStats(data.progress) << "." << endl;
+    }
 }
 
 /*****************************************************************************/
@@ -33,6 +33,7 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <vector>
 using namespace std;
 
 #include "CommandFoeWrite.h"
@@ -56,7 +57,9 @@ string CommandFoeWrite::helpString(const string &binaryBaseName) const
         << endl
         << getBriefDescription() << endl
         << endl
-        << "This command requires a single slave to be selected." << endl
+        << "If multiple slaves are selected, the file is written" << endl
+        << "to all of them in parallel. This requires the --force" << endl
+        << "option. The result is reported for each slave." << endl
         << endl
         << "Arguments:" << endl
         << "  FILENAME can either be a path to a file, or '-'. In" << endl
@@ -73,6 +76,8 @@ string CommandFoeWrite::helpString(const string &binaryBaseName) const
         << "  --alias       -a <alias>" << endl
         << "  --position    -p <pos>    Slave selection. See the help" << endl
         << "                            of the 'slaves' command." << endl
+        << "  --force       -f          Acknowledge writing to" << endl
+        << "                            multiple slaves." << endl
         << endl
         << numericInfo();
 
@@ -84,10 +89,13 @@ string CommandFoeWrite::helpString(const string &binaryBaseName) const
 void CommandFoeWrite::execute(const StringVector &args)
 {
     stringstream err;
-    ec_ioctl_slave_foe_t data;
+    ec_ioctl_slave_foe_stream_t data;
     ifstream file;
+    istream *in = &cin;
     SlaveList slaves;
     string storeFileName;
+    uint32_t password = 0;
+    uint8_t *buffer;
 
     if (args.size() < 1 || args.size() > 2) {
         err << "'" << getName() << "' takes one or two arguments!";
@@ -95,7 +103,6 @@ void CommandFoeWrite::execute(const StringVector &args)
     }
 
     if (args[0] == "-") {
-        loadFoeData(&data, cin);
         if (getOutputFile().empty()) {
             err << "Please specify a filename for the slave side"
                 << " with --output-file!";
@@ -109,8 +116,7 @@ void CommandFoeWrite::execute(const StringVector &args)
             err << "Failed to open '" << args[0] << "'!";
             throwCommandException(err);
         }
-        loadFoeData(&data, file);
-        file.close();
+        in = &file;
         if (getOutputFile().empty()) {
             char *cpy = strdup(args[0].c_str()); // basename can modify
                                                  // the string contents
@@ -121,77 +127,121 @@ void CommandFoeWrite::execute(const StringVector &args)
         }
     }
 
-    MasterDevice m(getSingleMasterIndex());
-    try {
-        m.open(MasterDevice::ReadWrite);
-    } catch (MasterDeviceException &e) {
-        if (data.buffer_size)
-            delete [] data.buffer;
-        throw e;
+    if (args.size() >= 2) {
+        stringstream strPassword;
+        strPassword << args[1];
+        strPassword
+            >> resetiosflags(ios::basefield) // guess base from prefix
+            >> password;
+        if (strPassword.fail()) {
+            err << "Invalid password '" << args[1] << "'!";
+            throwInvalidUsageException(err);
+        }
     }
 
+    MasterDevice m(getSingleMasterIndex());
+    m.open(MasterDevice::ReadWrite);
+
     slaves = selectedSlaves(m);
+    if (slaves.size() > 1) {
+        if (!getForce()) {
+            err << "This will write '" << storeFileName << "' to "
+                << slaves.size() << " slaves!"
+                << " Please specify --force to proceed.";
+            throwCommandException(err);
+        }
+        writeBulk(m, slaves, *in, storeFileName, password);
+        return;
+    }
     if (slaves.size() != 1) {
-        if (data.buffer_size)
-            delete [] data.buffer;
         throwSingleSlaveRequired(slaves.size());
     }
+
+    memset(&data, 0, sizeof(data));
     data.slave_position = slaves.front().position;
+    data.dir = EC_DIR_OUTPUT;
 
     // write data via foe to the slave
-    data.offset = 0;
-    data.password = 0;
+    data.password = password;
     strncpy(data.file_name, storeFileName.c_str(), sizeof(data.file_name));
     data.file_name[sizeof(data.file_name)-1] = 0;
-    if (args.size() >= 2) {
-        stringstream strPassword;
-        strPassword << args[1];
-        strPassword
-            >> resetiosflags(ios::basefield) // guess base from prefix
-            >> data.password;
-        if (strPassword.fail()) {
-            err << "Invalid password '" << args[1] << "'!";
-            throwInvalidUsageException(err);
+
+    // pass the file to the master in chunks
+    buffer = new uint8_t[chunkSize];
+    startTransfer();
+
+    do {
+        in->read((char *) buffer, chunkSize);
+        if (in->bad()) {
+            delete [] buffer;
+            err << "Failed to read FoE data!";
+            throwCommandException(err);
         }
-    }
+        data.buffer = buffer;
+        data.size = in->gcount();
+        data.last = in->eof();
 
-    try {
-        m.writeFoe(&data);
-    } catch (MasterDeviceException &e) {
-        if (data.buffer_size)
-            delete [] data.buffer;
-        if (data.result) {
-            if (data.result == FOE_OPCODE_ERROR) {
-                err << "FoE write aborted with error code 0x"
-                    << setw(8) << setfill('0') << hex << data.error_code
-                    << ": " << errorText(data.error_code);
+        try {
+            m.streamFoe(&data);
+        } catch (MasterDeviceException &e) {
+            delete [] buffer;
+            if (getVerbosity() == Verbose) {
+                cerr << endl;
+            }
+            if (data.result) {
+                if (data.result == FOE_OPCODE_ERROR) {
+                    err << "FoE write aborted with error code 0x"
+                        << setw(8) << setfill('0') << hex << data.error_code
+                        << ": " << errorText(data.error_code);
+                } else {
+                    err << "Failed to write via FoE: "
+                        << resultText(data.result);
+                }
+                throwCommandException(err);
             } else {
-                err << "Failed to write via FoE: "
-                    << resultText(data.result);
+                throw e;
             }
-            throwCommandException(err);
-        } else {
-            throw e;
         }
-    }
+
+        if (getVerbosity() == Verbose) {
+            cerr << "\rWritten " << data.progress << " bytes." << flush;
+        }
+    } while (!data.done);
+
+    delete [] buffer;
 
     if (getVerbosity() == Verbose) {
-        cerr << "FoE writing finished." << endl;
+        cerr << endl << "FoE writing finished." << endl;
     }
 
-    if (data.buffer_size)
-        delete [] data.buffer;
+    if (getVerbosity() != Quiet) {
+        cerr << "Wrote " << transferStats(data.progress) << "." << endl;
+    }
 }
 
 /*****************************************************************************/
 
-void CommandFoeWrite::loadFoeData(
-        ec_ioctl_slave_foe_t *data,
-        const istream &in
+/** Writes a file to multiple slaves in parallel.
+ *
+ * The file is loaded completely, because the master shares one copy of it
+ * between all slaves.
+ */
+void CommandFoeWrite::writeBulk(
+        MasterDevice &m,
+        const SlaveList &slaves,
+        istream &in,
+        const string &storeFileName,
+        uint32_t password
         )
 {
-    stringstream err;
+    ec_ioctl_slave_foe_bulk_t data;
+    vector<uint16_t> positions;
+    vector<ec_ioctl_foe_bulk_slave_t> status(slaves.size());
+    SlaveList::const_iterator si;
     ostringstream tmp;
+    stringstream err;
+    size_t progress;
+    unsigned int i, failed = 0;
 
     tmp << in.rdbuf();
     string const &contents = tmp.str();
@@ -200,12 +250,69 @@ void CommandFoeWrite::loadFoeData(
         cerr << "Read " << contents.size() << " bytes of FoE data." << endl;
     }
 
-    data->buffer_size = contents.size();
+    for (si = slaves.begin(); si != slaves.end(); si++) {
+        positions.push_back(si->position);
+    }
+
+    memset(&data, 0, sizeof(data));
+    data.password = password;
+    data.slave_count = positions.size();
+    data.slave_positions = &positions.front();
+    data.buffer_size = contents.size();
+    data.buffer = (uint8_t *) contents.data();
+    data.slaves = &status.front();
+    strncpy(data.file_name, storeFileName.c_str(), sizeof(data.file_name));
+    data.file_name[sizeof(data.file_name)-1] = 0;
+
+    startTransfer();
+
+    do {
+        m.writeFoeBulk(&data);
+
+        if (getVerbosity() == Verbose) {
+            progress = 0;
+            for (i = 0; i < data.slave_count; i++) {
+                progress += status[i].progress;
+            }
+            cerr << "\rFinished " << data.finished << " of "
+                << data.slave_count << " slaves, written " << progress
+                << " of " << contents.size() * data.slave_count
+                << " bytes." << flush;
+        }
+    } while (!data.done);
+
+    if (getVerbosity() == Verbose) {
+        cerr << endl;
+    }
+
+    for (i = 0, si = slaves.begin(); si != slaves.end(); i++, si++) {
+        cout << "Slave " << si->position << ": ";
+        if (status[i].state == EC_REQUEST_SUCCESS) {
+            cout << "OK" << endl;
+            continue;
+        }
+
+        failed++;
+        if (status[i].result == FOE_OPCODE_ERROR) {
+            cout << "Aborted with error code 0x"
+                << setw(8) << setfill('0') << hex << status[i].error_code
+                << dec << setfill(' ') << ": "
+                << errorText(status[i].error_code) << endl;
+        } else {
+            cout << "Failed after " << status[i].progress << " bytes: "
+                << resultText(status[i].result) << endl;
+        }
+    }
+
+    if (getVerbosity() != Quiet) {
+        cerr << "Wrote " << transferStats(contents.size()) << " to "
+            << slaves.size() << " slaves." << endl;
+    }
 
-    if (data->buffer_size) {
-        // allocate buffer and read file into buffer
-        data->buffer = new uint8_t[data->buffer_size];
-        contents.copy((char *) data->buffer, contents.size());
+    if (failed) {
+        err << "FoE write failed for " << failed << " of "
+            << slaves.size() << " slaves!";
+        throwCommandException(err);
     }
 }
 
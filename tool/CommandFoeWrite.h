@@ -44,7 +44,8 @@ class CommandFoeWrite:
         void execute(const StringVector &);
 
     protected:
-        void loadFoeData(ec_ioctl_slave_foe_t *, const istream &);
+        void writeBulk(MasterDevice &, const SlaveList &, istream &,
+                const string &, uint32_t);
 };
 
 /****************************************************************************/
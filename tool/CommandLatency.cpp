@@ -0,0 +1,253 @@
+/*****************************************************************************
+ *
+ *  $Id$
+ *
+ *  Copyright (C) 2006-2009  Florian Pose, Ingenieurgemeinschaft IgH
+ *
+ *  This file is part of the IgH EtherCAT Master.
+ *
+ *  The IgH EtherCAT Master is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License version 2, as
+ *  published by the Free Software Foundation.
+ *
+ *  The IgH EtherCAT Master is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ *  Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with the IgH EtherCAT Master; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *  ---
+ *
+ *  The license mentioned above concerns the source code only. Using the
+ *  EtherCAT technology and brand is only permitted in compliance with the
+ *  industrial property and similar rights of Beckhoff Automation GmbH.
+ *
+ *  vim: expandtab
+ *
+ ****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <unistd.h>
+using namespace std;
+
+#include "CommandLatency.h"
+#include "MasterDevice.h"
+
+/*****************************************************************************/
+
+static const char *classNames[EC_DATAGRAM_CLASS_COUNT] = {
+    "other",
+    "domain",
+    "dc",
+    "fsm",
+    "slave-fsm",
+    "eoe"
+};
+
+/*****************************************************************************/
+
+CommandLatency::CommandLatency():
+    Command("latency", "Show datagram round-trip latency statistics.")
+{
+}
+
+/****************************************************************************/
+
+string CommandLatency::helpString(const string &binaryBaseName) const
+{
+    stringstream str;
+
+    str << binaryBaseName << " " << getName() << " [OPTIONS] [INTERVAL]"
+        << endl
+        << endl
+        << getBriefDescription() << endl
+        << endl
+        << "The round-trip time of every received datagram is accounted"
+        << endl
+        << "per sending device and per datagram class:" << endl
+        << "  domain     Cyclic process data," << endl
+        << "  dc         Distributed clocks synchronisation," << endl
+        << "  fsm        Master state machine," << endl
+        << "  slave-fsm  Slave state machines," << endl
+        << "  eoe        Ethernet over EtherCAT," << endl
+        << "  other      Any other datagrams." << endl
+        << endl
+        << "Times are given in microseconds. Percentiles are estimated"
+        << endl
+        << "from a logarithmic histogram and therefore denote the upper"
+        << endl
+        << "bound of the respective histogram bin." << endl
+        << endl
+        << "Arguments:" << endl
+        << "  INTERVAL  If given, the statistics are output repeatedly" << endl
+        << "            every INTERVAL seconds until interrupted." << endl
+        << endl
+        << "Command-specific options:" << endl
+        << "  --master  -m <indices>  Master indices. A comma-separated"
+        << endl
+        << "                          list with ranges is supported." << endl
+        << "                          Example: 1,4,5,7-9. Default: - (all)."
+        << endl
+        << "  --reset   -r            Reset the statistics after output."
+        << endl
+        << "                          Combined with INTERVAL, every output"
+        << endl
+        << "                          covers the last interval only." << endl
+        << "  --verbose -v            Output the histogram bins, too." << endl
+        << endl
+        << numericInfo();
+
+    return str.str();
+}
+
+/****************************************************************************/
+
+void CommandLatency::execute(const StringVector &args)
+{
+    MasterIndexList masterIndices;
+    double interval = 0.0;
+
+    if (args.size() > 1) {
+        stringstream err;
+        err << "'" << getName() << "' takes max one argument!";
+        throwInvalidUsageException(err);
+    }
+
+    if (args.size()) {
+        stringstream str;
+        str << args[0];
+        str >> interval;
+        if (str.fail() || interval <= 0.0) {
+            stringstream err;
+            err << "Invalid interval '" << args[0] << "'!";
+            throwInvalidUsageException(err);
+        }
+    }
+
+    masterIndices = getMasterIndices();
+
+    while (1) {
+        MasterIndexList::const_iterator mi;
+        for (mi = masterIndices.begin();
+                mi != masterIndices.end(); mi++) {
+            MasterDevice m(*mi);
+            m.open(getReset() ? MasterDevice::ReadWrite : MasterDevice::Read);
+            showLatency(m);
+            if (getReset()) {
+                m.resetLatency();
+            }
+        }
+
+        if (interval <= 0.0) {
+            break;
+        }
+
+        cout.flush();
+        usleep((useconds_t) (interval * 1e6));
+        cout << endl;
+    }
+}
+
+/****************************************************************************/
+
+void CommandLatency::showLatency(MasterDevice &m)
+{
+    ec_ioctl_master_t master;
+    ec_ioctl_master_latency_t data;
+    unsigned int dev_idx, cls, bin;
+
+    m.getMaster(&master);
+
+    cout << "Master" << m.getIndex() << endl;
+
+    for (dev_idx = EC_DEVICE_MAIN; dev_idx < master.num_devices;
+            dev_idx++) {
+        cout << "  " << (dev_idx == EC_DEVICE_MAIN ? "Main" : "Backup")
+            << " device:" << endl
+            << "    " << left << setw(10) << "Class" << right
+            << setw(ColWidth + 3) << "Count"
+            << setw(ColWidth) << "Min"
+            << setw(ColWidth) << "Avg"
+            << setw(ColWidth) << "P50"
+            << setw(ColWidth) << "P99"
+            << setw(ColWidth) << "P99.9"
+            << setw(ColWidth) << "Max" << endl;
+
+        for (cls = 0; cls < EC_DATAGRAM_CLASS_COUNT; cls++) {
+            m.getLatency(&data, dev_idx, cls);
+
+            cout << "    " << left << setw(10) << classNames[cls] << right
+                << setw(ColWidth + 3) << data.count;
+
+            if (!data.count) {
+                cout << endl;
+                continue;
+            }
+
+            cout << fixed << setprecision(1)
+                << setw(ColWidth) << data.min_ns / 1000.0
+                << setw(ColWidth)
+                << (double) data.sum_ns / data.count / 1000.0
+                << setw(ColWidth) << percentile(data, 0.5) / 1000.0
+                << setw(ColWidth) << percentile(data, 0.99) / 1000.0
+                << setw(ColWidth) << percentile(data, 0.999) / 1000.0
+                << setw(ColWidth) << data.max_ns / 1000.0
+                << endl;
+
+            if (getVerbosity() != Verbose) {
+                continue;
+            }
+
+            for (bin = 0; bin < EC_LATENCY_BIN_COUNT; bin++) {
+                if (!data.bins[bin]) {
+                    continue;
+                }
+                cout << "      < " << setw(ColWidth + 3)
+                    << (double) (2ULL << bin) / 1000.0 << ": "
+                    << data.bins[bin] << endl;
+            }
+        }
+    }
+}
+
+/****************************************************************************/
+
+/** Estimates a percentile from the histogram bins.
+ *
+ * \return Upper bound of the bin containing the percentile [ns].
+ */
+double CommandLatency::percentile(
+        const ec_ioctl_master_latency_t &data,
+        double fraction
+        )
+{
+    uint64_t limit = (uint64_t) (fraction * data.count + 0.5), sum = 0;
+    unsigned int bin;
+    double upper;
+
+    if (!limit) {
+        limit = 1;
+    }
+
+    for (bin = 0; bin < EC_LATENCY_BIN_COUNT - 1; bin++) {
+        sum += data.bins[bin];
+        if (sum >= limit) {
+            break;
+        }
+    }
+
+    upper = (double) ((2ULL << bin) - 1);
+    if (upper > data.max_ns) {
+        upper = data.max_ns;
+    }
+    if (upper < data.min_ns) {
+        upper = data.min_ns;
+    }
+    return upper;
+}
+
+/*****************************************************************************/
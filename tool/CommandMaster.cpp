@@ -29,6 +29,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <net/ethernet.h>
 using namespace std;
 
 #include "CommandMaster.h"
@@ -102,7 +103,21 @@ void CommandMaster::execute(const StringVector &args)
         cout << endl
             << "  Active: " << (data.active ? "yes" : "no") << endl
             << "  Slaves: " << data.slave_count << endl
-            << "  Ethernet devices:" << endl;
+            << "  Last bus scan: " << data.scan_duration << " ms"
+            << (data.scan_incremental ? " (incremental)" : "") << endl;
+
+        if (data.active) {
+            cout << "  Activation to OP: ";
+            if (data.op_pending) {
+                cout << "pending";
+            } else {
+                cout << data.op_duration << " ms"
+                    << (data.op_grouped ? " (grouped)" : "");
+            }
+            cout << endl;
+        }
+
+        cout << "  Ethernet devices:" << endl;
 
         for (dev_idx = EC_DEVICE_MAIN; dev_idx < data.num_devices;
                 dev_idx++) {
@@ -256,6 +271,26 @@ void CommandMaster::execute(const StringVector &args)
         }
         cout << setprecision(0) << endl;
 
+        double frames_per_cycle = 0.0, frame_fill = 0.0;
+        if (data.cycle_count) {
+            frames_per_cycle = (double) data.cycle_frames / data.cycle_count;
+        }
+        if (data.cycle_frames) {
+            frame_fill = 100.0 * data.cycle_frame_bytes
+                / (data.cycle_frames * (double) ETH_DATA_LEN);
+        }
+        cout << "      Frames per cycle:    "
+            << setprecision(2) << fixed << frames_per_cycle
+            << " (last " << data.last_cycle_frames << ")" << endl
+            << "      Frame fill [%]:      "
+            << setprecision(1) << fixed << frame_fill
+            << setprecision(0) << endl
+            << "      Timed out datagrams: " << data.timeouts
+            << " (last cycle " << data.last_cycle_timeouts << ")" << endl
+            << "      Mailbox status LRDs: " << data.mbox_status_reads
+            << " (answering " << data.mbox_status_checks
+            << " mailbox checks)" << endl;
+
         cout << "  Distributed clocks:" << endl
             << "    Reference clock:   ";
         if (data.ref_clock != 0xffff) {
@@ -0,0 +1,259 @@
+/*****************************************************************************
+ *
+ *  $Id$
+ *
+ *  Copyright (C) 2006-2009  Florian Pose, Ingenieurgemeinschaft IgH
+ *
+ *  This file is part of the IgH EtherCAT Master.
+ *
+ *  The IgH EtherCAT Master is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License version 2, as
+ *  published by the Free Software Foundation.
+ *
+ *  The IgH EtherCAT Master is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ *  Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with the IgH EtherCAT Master; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *  ---
+ *
+ *  The license mentioned above concerns the source code only. Using the
+ *  EtherCAT technology and brand is only permitted in compliance with the
+ *  industrial property and similar rights of Beckhoff Automation GmbH.
+ *
+ ****************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+using namespace std;
+
+#include "CommandSiiCache.h"
+#include "sii_crc.h"
+#include "MasterDevice.h"
+
+/*****************************************************************************/
+
+/** Identifies an SII cache file (and its format version).
+ */
+static const char cacheMagic[8] = {'E', 'C', 'S', 'I', 'I', 'C', '0', '1'};
+
+/*****************************************************************************/
+
+CommandSiiCache::CommandSiiCache():
+    Command("sii_cache", "Save or load the persistent SII cache.")
+{
+}
+
+/*****************************************************************************/
+
+string CommandSiiCache::helpString(const string &binaryBaseName) const
+{
+    stringstream str;
+
+    str << binaryBaseName << " " << getName()
+        << " [OPTIONS] <save|load> <FILENAME>" << endl
+        << endl
+        << getBriefDescription() << endl
+        << endl
+        << "The master caches the SII contents of all slaves that can be"
+        << endl
+        << "uniquely identified by their alias or serial number. 'save'"
+        << endl
+        << "writes these images to a file, 'load' passes them back to the"
+        << endl
+        << "master, for example after a reboot. When a matching slave is"
+        << endl
+        << "scanned, the master only reads the slave's SII checksum to"
+        << endl
+        << "validate a loaded image, instead of reading the whole SII."
+        << endl
+        << endl
+        << "This command requires a single master to be selected." << endl
+        << endl
+        << "Arguments:" << endl
+        << "  FILENAME  Path of the cache file." << endl
+        << endl
+        << "Command-specific options:" << endl
+        << "  --master -m <index>  Master index." << endl
+        << endl;
+
+    return str.str();
+}
+
+/****************************************************************************/
+
+void CommandSiiCache::execute(const StringVector &args)
+{
+    stringstream err;
+
+    if (args.size() != 2) {
+        err << "'" << getName() << "' takes exactly two arguments!";
+        throwInvalidUsageException(err);
+    }
+
+    MasterDevice m(getSingleMasterIndex());
+
+    if (args[0] == "save") {
+        m.open(MasterDevice::Read);
+        saveCache(m, args[1]);
+    } else if (args[0] == "load") {
+        m.open(MasterDevice::ReadWrite);
+        loadCache(m, args[1]);
+    } else {
+        err << "Invalid action '" << args[0] << "'!";
+        throwInvalidUsageException(err);
+    }
+}
+
+/****************************************************************************/
+
+void CommandSiiCache::saveCache(
+        MasterDevice &m,
+        const string &fileName
+        )
+{
+    stringstream err;
+    ec_ioctl_sii_cache_t data;
+    string tmpName = fileName + ".tmp";
+    ofstream file;
+    uint16_t *words = NULL;
+    uint32_t size = 0, index = 0;
+
+    file.open(tmpName.c_str(), ofstream::out | ofstream::binary
+            | ofstream::trunc);
+    if (file.fail()) {
+        err << "Failed to open '" << tmpName << "'!";
+        throwCommandException(err);
+    }
+
+    file.write(cacheMagic, sizeof(cacheMagic));
+
+    do {
+        data.index = index;
+        data.nwords = size;
+        data.words = words;
+
+        try {
+            m.readSiiCache(&data);
+        } catch (MasterDeviceException &e) {
+            delete [] words;
+            file.close();
+            remove(tmpName.c_str());
+            throw e;
+        }
+
+        if (!data.nwords) {
+            break; // image vanished
+        }
+
+        if (data.nwords > size) {
+            // buffer too small; enlarge and fetch again
+            delete [] words;
+            size = data.nwords;
+            words = new uint16_t[size];
+            continue;
+        }
+
+        file.write((const char *) &data.nwords, sizeof(data.nwords));
+        file.write((const char *) words, data.nwords * 2);
+        index++;
+    } while (index < data.count);
+
+    delete [] words;
+    file.close();
+
+    if (file.fail() || rename(tmpName.c_str(), fileName.c_str())) {
+        remove(tmpName.c_str());
+        err << "Failed to write '" << fileName << "'!";
+        throwCommandException(err);
+    }
+
+    if (getVerbosity() == Verbose) {
+        cerr << "Saved " << index << " SII images." << endl;
+    }
+}
+
+/****************************************************************************/
+
+void CommandSiiCache::loadCache(
+        MasterDevice &m,
+        const string &fileName
+        )
+{
+    stringstream err;
+    ec_ioctl_sii_cache_t data;
+    ifstream file;
+    ostringstream tmp;
+    size_t offset;
+    unsigned int loaded = 0;
+
+    file.open(fileName.c_str(), ifstream::in | ifstream::binary);
+    if (file.fail()) {
+        err << "Failed to open '" << fileName << "'!";
+        throwCommandException(err);
+    }
+    tmp << file.rdbuf();
+    file.close();
+
+    string const &contents = tmp.str();
+
+    if (contents.size() < sizeof(cacheMagic)
+            || memcmp(contents.data(), cacheMagic, sizeof(cacheMagic))) {
+        err << "'" << fileName << "' is not an SII cache file!";
+        throwCommandException(err);
+    }
+
+    offset = sizeof(cacheMagic);
+    while (offset < contents.size()) {
+        uint32_t nwords;
+        uint16_t *words;
+
+        if (offset + sizeof(nwords) > contents.size()) {
+            err << "Unexpected end of '" << fileName << "'!";
+            throwCommandException(err);
+        }
+        memcpy(&nwords, contents.data() + offset, sizeof(nwords));
+        offset += sizeof(nwords);
+
+        if (nwords > (contents.size() - offset) / 2) {
+            err << "Unexpected end of '" << fileName << "'!";
+            throwCommandException(err);
+        }
+        words = new uint16_t[nwords];
+        memcpy(words, contents.data() + offset, nwords * 2);
+        offset += nwords * 2;
+
+        // skip corrupted images
+        if (nwords < 8 || calcSiiCrc((const uint8_t *) words, 14)
+                != ((const uint8_t *) words)[14]) {
+            cerr << "Skipping SII image with invalid checksum." << endl;
+            delete [] words;
+            continue;
+        }
+
+        data.index = 0;
+        data.nwords = nwords;
+        data.words = words;
+
+        try {
+            m.loadSiiCache(&data);
+            loaded++;
+        } catch (MasterDeviceException &e) {
+            cerr << e.what() << endl;
+        }
+
+        delete [] words;
+    }
+
+    if (getVerbosity() == Verbose) {
+        cerr << "Loaded " << loaded << " SII images." << endl;
+    }
+}
+
+/*****************************************************************************/
@@ -253,8 +253,14 @@ void CommandSlaves::showSlaves(
         cout
             << "Device: " << (si->device_index ? "Backup" : "Main") << endl
             << "State: " << alStateString(si->al_state) << endl
-            << "Flag: " << (si->error_flag ? 'E' : '+') << endl
-            << "Identity:" << endl
+            << "Flag: " << (si->error_flag ? 'E' : '+') << endl;
+
+        if (si->config_round_trips) {
+            cout << "Last configuration: " << dec << si->config_duration
+                << " ms, " << si->config_round_trips << " datagrams" << endl;
+        }
+
+        cout << "Identity:" << endl
             << "  Vendor Id:       0x"
             << hex << setfill('0')
             << setw(8) << si->vendor_id << endl
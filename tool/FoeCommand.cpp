@@ -27,10 +27,17 @@
  *
  ****************************************************************************/
 
+#include <iomanip>
+using namespace std;
+
 #include "FoeCommand.h"
 
 /*****************************************************************************/
 
+const unsigned int FoeCommand::chunkSize = 16384;
+
+/*****************************************************************************/
+
 FoeCommand::FoeCommand(const string &name, const string &briefDesc):
     Command(name, briefDesc)
 {
@@ -113,3 +120,35 @@ std::string FoeCommand::errorText(int errorCode)
 }
 
 /****************************************************************************/
+
+void FoeCommand::startTransfer()
+{
+    gettimeofday(&transferStart, NULL);
+}
+
+/****************************************************************************/
+
+/** Returns the transferred bytes, the duration and the throughput since
+ * startTransfer().
+ */
+std::string FoeCommand::transferStats(size_t bytes) const
+{
+    struct timeval now;
+    double seconds;
+    stringstream str;
+
+    gettimeofday(&now, NULL);
+    seconds = (now.tv_sec - transferStart.tv_sec)
+        + (now.tv_usec - transferStart.tv_usec) / 1e6;
+
+    str << bytes << " bytes in " << fixed << setprecision(3)
+        << seconds << " s";
+    if (seconds > 0.0) {
+        str << " (" << setprecision(1) << bytes / 1024.0 / seconds
+            << " KiB/s)";
+    }
+
+    return str.str();
+}
+
+/****************************************************************************/
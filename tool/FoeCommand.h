@@ -30,6 +30,8 @@
 #ifndef __FOECOMMAND_H__
 #define __FOECOMMAND_H__
 
+#include <sys/time.h>
+
 #include "Command.h"
 
 /****************************************************************************/
@@ -43,6 +45,15 @@ class FoeCommand:
     protected:
         static std::string resultText(int);
         static std::string errorText(int);
+
+        static const unsigned int chunkSize; /**< Size of the file chunks
+                                               passed to the master. */
+
+        void startTransfer();
+        std::string transferStats(size_t) const;
+
+    private:
+        struct timeval transferStart; /**< Start of the transfer. */
 };
 
 /****************************************************************************/
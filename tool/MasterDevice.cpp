@@ -267,6 +267,32 @@ void MasterDevice::getPcap(ec_ioctl_pcap_data_t *data,
 
 /****************************************************************************/
 
+void MasterDevice::getLatency(ec_ioctl_master_latency_t *data,
+        unsigned int deviceIndex, unsigned int datagramClass)
+{
+    data->device_index = deviceIndex;
+    data->datagram_class = datagramClass;
+
+    if (ioctl(fd, EC_IOCTL_MASTER_LATENCY, data) < 0) {
+        stringstream err;
+        err << "Failed to get latency statistics: " << strerror(errno);
+        throw MasterDeviceException(err);
+    }
+}
+
+/****************************************************************************/
+
+void MasterDevice::resetLatency()
+{
+    if (ioctl(fd, EC_IOCTL_MASTER_LATENCY_RESET, 0) < 0) {
+        stringstream err;
+        err << "Failed to reset latency statistics: " << strerror(errno);
+        throw MasterDeviceException(err);
+    }
+}
+
+/****************************************************************************/
+
 void MasterDevice::getSlave(ec_ioctl_slave_t *slave, uint16_t slaveIndex)
 {
     slave->position = slaveIndex;
@@ -426,6 +452,32 @@ void MasterDevice::writeSii(
 
 /****************************************************************************/
 
+void MasterDevice::readSiiCache(
+        ec_ioctl_sii_cache_t *data
+        )
+{
+    if (ioctl(fd, EC_IOCTL_SII_CACHE_READ, data) < 0) {
+        stringstream err;
+        err << "Failed to read SII cache: " << strerror(errno);
+        throw MasterDeviceException(err);
+    }
+}
+
+/****************************************************************************/
+
+void MasterDevice::loadSiiCache(
+        ec_ioctl_sii_cache_t *data
+        )
+{
+    if (ioctl(fd, EC_IOCTL_SII_CACHE_LOAD, data) < 0) {
+        stringstream err;
+        err << "Failed to load SII cache: " << strerror(errno);
+        throw MasterDeviceException(err);
+    }
+}
+
+/****************************************************************************/
+
 void MasterDevice::readReg(
         ec_ioctl_slave_reg_t *data
         )
@@ -491,6 +543,32 @@ void MasterDevice::writeFoe(
 
 /****************************************************************************/
 
+void MasterDevice::streamFoe(
+        ec_ioctl_slave_foe_stream_t *data
+        )
+{
+    if (ioctl(fd, EC_IOCTL_SLAVE_FOE_STREAM, data) < 0) {
+        stringstream err;
+        err << "Failed to transfer via FoE: " << strerror(errno);
+        throw MasterDeviceException(err);
+    }
+}
+
+/****************************************************************************/
+
+void MasterDevice::writeFoeBulk(
+        ec_ioctl_slave_foe_bulk_t *data
+        )
+{
+    if (ioctl(fd, EC_IOCTL_SLAVE_FOE_BULK, data) < 0) {
+        stringstream err;
+        err << "Failed to write via FoE: " << strerror(errno);
+        throw MasterDeviceException(err);
+    }
+}
+
+/****************************************************************************/
+
 void MasterDevice::setDebug(unsigned int debugLevel)
 {
     if (ioctl(fd, EC_IOCTL_MASTER_DEBUG, debugLevel) < 0) {
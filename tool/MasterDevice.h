@@ -140,6 +140,9 @@ class MasterDevice
                 unsigned char *);
         void getPcap(ec_ioctl_pcap_data_t *, unsigned char, unsigned int,
                 unsigned char *);
+        void getLatency(ec_ioctl_master_latency_t *, unsigned int,
+                unsigned int);
+        void resetLatency();
         void getSlave(ec_ioctl_slave_t *, uint16_t);
         void getSync(ec_ioctl_slave_sync_t *, uint16_t, uint8_t);
         void getPdo(ec_ioctl_slave_sync_pdo_t *, uint16_t, uint8_t, uint8_t);
@@ -149,6 +152,8 @@ class MasterDevice
         void getSdoEntry(ec_ioctl_slave_sdo_entry_t *, uint16_t, int, uint8_t);
         void readSii(ec_ioctl_slave_sii_t *);
         void writeSii(ec_ioctl_slave_sii_t *);
+        void readSiiCache(ec_ioctl_sii_cache_t *);
+        void loadSiiCache(ec_ioctl_sii_cache_t *);
         void readReg(ec_ioctl_slave_reg_t *);
         void writeReg(ec_ioctl_slave_reg_t *);
         void readWriteReg(ec_ioctl_slave_reg_t *);
@@ -161,6 +166,8 @@ class MasterDevice
         void requestRebootAll();
         void readFoe(ec_ioctl_slave_foe_t *);
         void writeFoe(ec_ioctl_slave_foe_t *);
+        void streamFoe(ec_ioctl_slave_foe_stream_t *);
+        void writeFoeBulk(ec_ioctl_slave_foe_bulk_t *);
 #ifdef EC_EOE
         void getEoeHandler(ec_ioctl_eoe_handler_t *, uint16_t);
         void addEoeIf(uint16_t, uint16_t);
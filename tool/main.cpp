@@ -55,6 +55,7 @@ using namespace std;
 #ifdef EC_EOE
 # include "CommandIp.h"
 #endif
+#include "CommandLatency.h"
 #include "CommandMaster.h"
 #include "CommandPcap.h"
 #include "CommandPdos.h"
@@ -64,6 +65,7 @@ using namespace std;
 #include "CommandReboot.h"
 #include "CommandRescan.h"
 #include "CommandSdos.h"
+#include "CommandSiiCache.h"
 #include "CommandSiiRead.h"
 #include "CommandSiiWrite.h"
 #include "CommandSlaves.h"
@@ -321,6 +323,7 @@ int main(int argc, char **argv)
 #ifdef EC_EOE
     commandList.push_back(new CommandIp());
 #endif
+    commandList.push_back(new CommandLatency());
     commandList.push_back(new CommandMaster());
     commandList.push_back(new CommandPcap());
     commandList.push_back(new CommandPdos());
@@ -330,6 +333,7 @@ int main(int argc, char **argv)
     commandList.push_back(new CommandReboot());
     commandList.push_back(new CommandRescan());
     commandList.push_back(new CommandSdos());
+    commandList.push_back(new CommandSiiCache());
     commandList.push_back(new CommandSiiRead());
     commandList.push_back(new CommandSiiWrite());
     commandList.push_back(new CommandSlaves());